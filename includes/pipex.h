@@ -6,15 +6,90 @@
 /*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/07 22:36:23 by fde-alen          #+#    #+#             */
-/*   Updated: 2024/01/22 00:04:15 by fde-alen         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:58:00 by fde-alen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef PIPEX_H
 # define PIPEX_H
 
+# ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+# endif
+
 # define ERROR 1
 
+# define LAUNCH_FORK 0
+# define LAUNCH_SPAWN 1
+
+# define MERGE_CONCAT 0
+# define MERGE_INTERLEAVE 1
+# define MERGE_SORTED 2
+
+# define PLACE_NONE 0
+# define PLACE_COMPACT 1
+# define PLACE_SPREAD 2
+
+# define LIST_STAGE_VALUE 0
+# define LIST_TEE 1
+# define LIST_CPUS 2
+# define LIST_PIPE_SIZE 3
+# define LIST_EDGE 4
+
+# define PRIO_KEEP INT_MIN
+# define IOPRIO_SHIFT 13
+# define IOPRIO_WHO_PROC 1
+
+# ifndef PIPEX_LAUNCHER
+#  define PIPEX_LAUNCHER LAUNCH_FORK
+# endif
+
+# define CACHE_MAGIC "pipex-cache 1\n"
+
+# ifndef PATH_INDEX_PROBES
+#  define PATH_INDEX_PROBES 256
+# endif
+# define DIRENT_BUF_SIZE 32768
+
+# define BUILTIN_BUF_SIZE 65536
+# define COPY_CHUNK_SIZE 1073741824
+# define REAP_EVENTS 64
+# define REAP_TIMER 0xffffffff
+# define REAP_SIGNAL 0xfffffffe
+# define TIMEOUT_STATUS 124
+# ifndef KILL_GRACE_MS
+#  define KILL_GRACE_MS 2000
+# endif
+# ifndef PARALLEL_CHUNK
+#  define PARALLEL_CHUNK 4194304
+# endif
+# ifndef TEE_CHUNK
+#  define TEE_CHUNK 1048576
+# endif
+# ifndef METER_CHUNK
+#  define METER_CHUNK 1048576
+# endif
+# ifndef ZYGOTE_MSG_SIZE
+#  define ZYGOTE_MSG_SIZE 65536
+# endif
+# ifndef HEREDOC_SPILL
+#  define HEREDOC_SPILL 67108864
+# endif
+# define HEREDOC_EOF 2
+# define SERVE_FDS 3
+# define ZYGOTE_FDS 5
+# define SERVE_MAX_FRAME 1048576
+# define SERVE_RECV_TIMEOUT 2
+# ifndef SERVE_PENDING
+#  define SERVE_PENDING 16
+# endif
+# define PIPE_SIZE_AUTO -1
+# define PIPE_DEFAULT_SIZE 65536
+# ifndef PIPE_AUTO_MAX
+#  define PIPE_AUTO_MAX 1048576
+# endif
+
+# include <limits.h>
 # include <stdlib.h>
 # include <stdio.h>
 # include <string.h>
@@ -23,10 +98,624 @@
 # include <fcntl.h>
 # include <unistd.h>
 # include <sys/wait.h>
+# include <sys/resource.h>
+# include <spawn.h>
+# include <sys/mman.h>
+# include <sys/sendfile.h>
+# include <sys/prctl.h>
+# include <sys/stat.h>
+# include <sys/syscall.h>
+# include <sys/epoll.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+# include <sys/inotify.h>
+# include <poll.h>
+# include <sys/signalfd.h>
+# include <sys/timerfd.h>
+# include <time.h>
+# include <signal.h>
+# include <sched.h>
+# include <dirent.h>
 
 # include "../libs/ft_printf/ft_printf.h"
 # include "../libs/libft/libft.h"
 
+# ifndef SYS_execveat
+#  define SYS_execveat -1
+# endif
+# ifndef SYS_pidfd_open
+#  define SYS_pidfd_open -1
+# endif
+# ifndef SYS_pidfd_send_signal
+#  define SYS_pidfd_send_signal -1
+# endif
+# ifndef SYS_close_range
+#  define SYS_close_range -1
+# endif
+# ifndef SYS_ioprio_set
+#  define SYS_ioprio_set -1
+# endif
+
+/**
+ * Runtime options given on the command line before the infile argument.
+ *
+ * Options start with "--" and are consumed by `parse_options` before the
+ * pipeline arguments are validated. A lone "--" ends option parsing.
+ *
+ * Members:
+ * @param launcher      How stages are started, LAUNCH_FORK or LAUNCH_SPAWN.
+ *                      Defaults to PIPEX_LAUNCHER, set at build time.
+ * @param cache         Non-zero to use the on-disk command resolution cache.
+ * @param builtins      Non-zero to run known commands in-process, see
+ *                      `find_builtin`. Cleared by --no-builtins.
+ * @param rewrite       Non-zero to simplify the planned pipeline, see
+ *                      `rewrite_stages`. Set by --rewrite, cleared by
+ *                      --no-rewrite.
+ * @param print_plan    Non-zero to print the final plan, set by --print-plan.
+ * @param pipestatus    Non-zero to print the exit status of every stage, set
+ *                      by --pipestatus.
+ * @param pipestatus_json File the exit status of every stage is written to as
+ *                      JSON, set by --pipestatus-json, or NULL.
+ * @param timeout       Time in ms the whole pipeline may run, set by
+ *                      --timeout, or 0 for no limit.
+ * @param kill_after    Time in ms between SIGTERM and SIGKILL for a stage
+ *                      past its deadline, set by --kill-after.
+ * @param stage_timeouts Time limits of single stages, a list of
+ *                      t_stage_value in ms, set by --stage-timeout.
+ * @param stats         Non-zero to print the resources used by every stage,
+ *                      set by --stats.
+ * @param stats_file    File the resources used by every stage are written to
+ *                      as JSON, set by --stats=FILE, or NULL.
+ * @param jit_pipes     Non-zero to create each pipe right before the stage
+ *                      writing to it, set by --jit-pipes.
+ * @param pipe_sizes    Pipe capacities requested with --pipe-size, a list of
+ *                      t_pipe_size in command line order.
+ * @param meter         Non-zero to relay pipes through a metering process,
+ *                      set by --meter.
+ * @param meter_edges   Pipes to meter, a list of int counting from 1 given
+ *                      with --meter=LIST, or NULL for every pipe.
+ * @param parallel      Number of workers of single stages, a list of
+ *                      t_stage_value set by --parallel.
+ * @param tees          Branches added with --tee, a list of t_tee.
+ * @param inputs        Inputs added with --input, a list of t_input.
+ * @param merge         How the inputs are merged, MERGE_CONCAT,
+ *                      MERGE_INTERLEAVE or MERGE_SORTED, set by --merge.
+ * @param batch         Manifest of the pipelines to run, set by --batch, or
+ *                      NULL to run the pipeline of the command line.
+ * @param jobs          Number of pipelines of the manifest run at once, set
+ *                      by --jobs, or 0 for one per available CPU.
+ * @param serve         Socket to accept pipelines on, set by --serve, or
+ *                      NULL.
+ * @param submit        Socket of the server to run the pipeline of the
+ *                      command line on, set by --submit, or NULL.
+ * @param zygotes       Number of helper processes forked ahead of the
+ *                      stages, set by --zygotes, or 0.
+ * @param placement     How stages are pinned to CPUs, PLACE_NONE,
+ *                      PLACE_COMPACT or PLACE_SPREAD, set by
+ *                      --cpu-placement.
+ * @param stage_cpus    CPUs of single stages, a list of t_stage_cpus set by
+ *                      --cpus.
+ * @param stage_nice    Nice values of the stages, a list of t_stage_value
+ *                      set by --nice.
+ * @param stage_sched   Scheduling policies of the stages, a list of
+ *                      t_stage_value set by --sched.
+ * @param stage_ioprio  I/O priorities of the stages, a list of t_stage_value
+ *                      set by --ioprio.
+ * @param heredoc_spill Size in bytes above which the here_doc body moves
+ *                      from memory to a temporary file, set by
+ *                      --heredoc-spill.
+ * @param heredoc_stream Non-zero to feed the here_doc body to the first stage
+ *                      while it is read, set by --heredoc-stream.
+ * @param given         Number of options given, counted by `parse_options`.
+ */
+typedef struct s_opts
+{
+	int		launcher;
+	int		cache;
+	int		builtins;
+	int		rewrite;
+	int		print_plan;
+	long	timeout;
+	long	kill_after;
+	t_list	*stage_timeouts;
+	int		stats;
+	char	*stats_file;
+	int		jit_pipes;
+	int		pipestatus;
+	char	*pipestatus_json;
+	t_list	*pipe_sizes;
+	int		meter;
+	t_list	*meter_edges;
+	t_list	*parallel;
+	t_list	*tees;
+	t_list	*inputs;
+	int		merge;
+	char	*batch;
+	int		jobs;
+	char	*serve;
+	char	*submit;
+	int		zygotes;
+	int		placement;
+	t_list	*stage_cpus;
+	t_list	*stage_nice;
+	t_list	*stage_sched;
+	t_list	*stage_ioprio;
+	long	heredoc_spill;
+	int		heredoc_stream;
+	int		given;
+}		t_opts;
+
+/**
+ * Capacity requested for the pipes of the pipeline with --pipe-size.
+ *
+ * Members:
+ * @param edge          Pipe the size applies to, 1 for the pipe between the
+ *                      first and second stages of the final plan, or 0 for
+ *                      every pipe without a size of its own.
+ * @param size          Capacity in bytes, or PIPE_SIZE_AUTO to derive it from
+ *                      the size of the input file.
+ */
+typedef struct s_pipe_size
+{
+	int	edge;
+	int	size;
+}		t_pipe_size;
+
+/**
+ * Branch added to the pipeline with --tee.
+ *
+ * Members:
+ * @param stage         Stage whose output is sent to the branch as well, 1
+ *                      for the first stage of the final plan.
+ * @param outfile       File the branch writes to.
+ * @param cmds          Commands of the branch, separated by '|', with "\|"
+ *                      standing for a '|' inside a command.
+ * @param pid           Process ID of the relay feeding the branch, or 0.
+ */
+typedef struct s_tee
+{
+	int		stage;
+	char	*outfile;
+	char	*cmds;
+	pid_t	pid;
+}		t_tee;
+
+/**
+ * Input added to the pipeline with --input.
+ *
+ * Members:
+ * @param file          File to read.
+ * @param cmds          Commands the file is run through before the merge,
+ *                      separated by '|', or NULL to read the file as is.
+ */
+typedef struct s_input
+{
+	char	*file;
+	char	*cmds;
+}		t_input;
+
+/**
+ * Buffered reader returning one line at a time.
+ *
+ * Members:
+ * @param fd            Descriptor read from.
+ * @param buf           Bytes read and not returned yet, from `start`.
+ * @param start         Offset of the first byte not returned yet.
+ * @param len           Number of bytes not returned yet.
+ * @param size          Number of bytes allocated for `buf`.
+ * @param eof           Non-zero once `fd` reached end of file.
+ */
+typedef struct s_reader
+{
+	int		fd;
+	char	*buf;
+	size_t	start;
+	size_t	len;
+	size_t	size;
+	int		eof;
+}		t_reader;
+
+/**
+ * Input of the merge process of --input, with its pending line.
+ *
+ * Members:
+ * @param reader        Reader of the input.
+ * @param line          Next line of the input, pointing into the reader.
+ * @param len           Length of `line`, 0 once the input is exhausted.
+ */
+typedef struct s_source
+{
+	t_reader	reader;
+	char		*line;
+	ssize_t		len;
+}		t_source;
+
+/**
+ * Storage of the here_doc body while it is read, see `heredoc_write`.
+ *
+ * Members:
+ * @param fd            Descriptor the body is written to.
+ * @param rd            Read end of the pipe while the body is kept in a pipe,
+ *                      -1 once it moved to a memfd or a temporary file.
+ * @param size          Number of bytes written so far.
+ * @param cap           Number of bytes the memfd may hold before the body
+ *                      moves to a temporary file.
+ * @param spill         Size at which the body moves from a memfd to a
+ *                      temporary file.
+ */
+typedef struct s_heredoc
+{
+	int		fd;
+	int		rd;
+	size_t	size;
+	size_t	cap;
+	size_t	spill;
+}		t_heredoc;
+
+/**
+ * Entry of the option table used by `parse_options`.
+ *
+ * Names ending in '=' take the rest of the argument as their value, other
+ * names must match exactly and are called with a NULL value.
+ *
+ * Members:
+ * @param name          Option name, including the leading "--".
+ * @param set           Setter called with the option value. Returns 0 on
+ *                      success and 1 if the value is invalid.
+ */
+typedef struct s_option
+{
+	char	*name;
+	int		(*set)(t_opts *opts, char *value);
+}		t_option;
+
+/**
+ * A command of the pipeline, resolved before any stage is started.
+ *
+ * Members:
+ * @param argv          Command name and arguments, split on spaces.
+ * @param path          Full path of the executable, or NULL if not found.
+ * @param exec_fd       O_PATH descriptor of the executable while the stage is
+ *                      being launched, -1 otherwise.
+ * @param builtin       In-process implementation of the command, or NULL to
+ *                      execute `path`.
+ * @param status        Wait status of the stage once reaped, -1 before.
+ * @param pidfd         Process descriptor watched by `reap_stages`, or -1.
+ * @param remote        Socket on which the helper that started the stage
+ *                      sends its wait status, see `zygote_exec`, or -1.
+ * @param deadline      CLOCK_MONOTONIC time in ms at which the stage is sent
+ *                      SIGTERM, or 0 for none.
+ * @param kill_at       CLOCK_MONOTONIC time in ms at which a stage that did
+ *                      not exit after SIGTERM is sent SIGKILL.
+ * @param timed_out     Number of signals sent because of the deadline, 0 if
+ *                      it was not reached.
+ * @param started       CLOCK_MONOTONIC time in us the stage was launched.
+ * @param ended         CLOCK_MONOTONIC time in us the stage was reaped.
+ * @param usage         Resources used by the stage, filled by `wait4`.
+ * @param workers       Number of worker processes running the command in
+ *                      parallel, see `run_parallel`, or 0 for one process.
+ * @param pinned        Non-zero if the stage runs on `cpus` only, see
+ *                      `plan_placement`.
+ * @param cpus          CPUs the stage is pinned to.
+ * @param nice          Nice value of the stage, or PRIO_KEEP.
+ * @param sched         Scheduling policy of the stage, or PRIO_KEEP.
+ * @param ioprio        I/O priority of the stage, or PRIO_KEEP.
+ * @param tuned         Non-zero if any of the three is set, see
+ *                      `plan_priorities`.
+ */
+typedef struct s_stage
+{
+	char			**argv;
+	char			*path;
+	int				exec_fd;
+	int				(*builtin)(char **argv);
+	int				status;
+	int				pidfd;
+	int				remote;
+	long			deadline;
+	long			kill_at;
+	int				timed_out;
+	long			started;
+	long			ended;
+	struct rusage	usage;
+	int				workers;
+	int				pinned;
+	cpu_set_t		cpus;
+	int				nice;
+	int				sched;
+	int				ioprio;
+	int				tuned;
+}		t_stage;
+
+/**
+ * CPUs given to a single stage with --cpus.
+ *
+ * Members:
+ * @param stage         Stage the CPUs apply to, 1 for the first stage of the
+ *                      final plan.
+ * @param cpus          The CPUs.
+ */
+typedef struct s_stage_cpus
+{
+	int			stage;
+	cpu_set_t	cpus;
+}		t_stage_cpus;
+
+/**
+ * Position of a CPU in the topology of the host, read from
+ * /sys/devices/system/cpu.
+ *
+ * Members:
+ * @param cpu           Number of the CPU.
+ * @param package       Physical package, or socket, of the CPU, or -1.
+ * @param core          Core of the CPU in its package, shared by its SMT
+ *                      siblings, or -1.
+ */
+typedef struct s_cpu
+{
+	int	cpu;
+	int	package;
+	int	core;
+}		t_cpu;
+
+/**
+ * Value of an option given for a single stage, or for every stage.
+ *
+ * Members:
+ * @param stage         Stage the value applies to, 1 for the first stage of
+ *                      the final plan, or 0 for every stage without a value
+ *                      of its own.
+ * @param value         The value.
+ */
+typedef struct s_stage_value
+{
+	int		stage;
+	long	value;
+}		t_stage_value;
+
+/**
+ * Descriptors watched by the wait loop of `reap_stages`.
+ *
+ * Members:
+ * @param epfd          The epoll instance.
+ * @param sfd           Signalfd receiving SIGCHLD when process descriptors
+ *                      are not available, or -1.
+ * @param tfd           Timerfd armed to the nearest deadline, or -1.
+ * @param old_mask      Signal mask to restore when `sfd` is used.
+ */
+typedef struct s_reaper
+{
+	int			epfd;
+	int			sfd;
+	int			tfd;
+	sigset_t	old_mask;
+}		t_reaper;
+
+/**
+ * Worker slot of a stage run in parallel.
+ *
+ * Members:
+ * @param pid           Process ID of the worker running the chunk held by
+ *                      the slot, or 0 if the slot is free.
+ * @param out           Memory file the worker writes its output to.
+ */
+typedef struct s_worker
+{
+	pid_t	pid;
+	int		out;
+}		t_worker;
+
+/**
+ * State of the process running a stage with --parallel.
+ *
+ * Members:
+ * @param stage         The stage, whose command every worker runs.
+ * @param envp          Environment passed to the workers.
+ * @param slots         One slot per worker, chunk n going to slot n % count.
+ * @param count         Number of workers.
+ * @param buf           Ring buffer of the input read but not handed to a
+ *                      worker yet.
+ * @param head          Offset in `buf` of the first pending byte.
+ * @param len           Number of pending bytes in `buf`.
+ * @param size          Number of bytes allocated for `buf`.
+ * @param eof           Non-zero once the standard input reached end of file.
+ * @param status        Exit code of the stage so far, -1 before the first
+ *                      worker exited.
+ */
+typedef struct s_parallel
+{
+	t_stage		*stage;
+	char		**envp;
+	t_worker	*slots;
+	int			count;
+	char		*buf;
+	size_t		head;
+	size_t		len;
+	size_t		size;
+	int			eof;
+	int			status;
+}		t_parallel;
+
+/**
+ * Traffic seen by the relay metering one pipe with --meter.
+ *
+ * The array of meters is mapped shared, each relay fills its own entry and
+ * the parent reads them all once the relays exited.
+ *
+ * Members:
+ * @param pid           Process ID of the relay, or 0 if the pipe is not
+ *                      metered.
+ * @param bytes         Number of bytes relayed.
+ * @param splices       Number of `splice` calls that moved data.
+ * @param read_wait     Time in us spent waiting for data from the writer.
+ * @param write_wait    Time in us spent waiting for room in the pipe of the
+ *                      reader, the backpressure of the reader.
+ * @param started       CLOCK_MONOTONIC time in us the relay started.
+ * @param ended         CLOCK_MONOTONIC time in us the relay saw end of file.
+ */
+typedef struct s_meter
+{
+	pid_t	pid;
+	long	bytes;
+	long	splices;
+	long	read_wait;
+	long	write_wait;
+	long	started;
+	long	ended;
+}		t_meter;
+
+/**
+ * Growable string used to build reports before writing them at once.
+ *
+ * Members:
+ * @param str           The characters, not NUL-terminated.
+ * @param len           Number of characters used.
+ * @param size          Number of characters allocated.
+ * @param error         Non-zero once an allocation failed, further additions
+ *                      are then ignored.
+ */
+typedef struct s_strbuf
+{
+	char	*str;
+	size_t	len;
+	size_t	size;
+	int		error;
+}		t_strbuf;
+
+/**
+ * On-disk cache of command resolutions for one PATH value.
+ *
+ * The cache file starts with CACHE_MAGIC, a "P <PATH>" line and one
+ * "D <mtime sec> <mtime nsec> <dir>" line per PATH directory, mtimes in hex.
+ * Entries follow, "C <cmd>\t<path>" for a found command and "N <cmd>" for a
+ * command that is not in PATH. The whole file is invalidated as soon as the
+ * mtime of one of the directories changes.
+ *
+ * Members:
+ * @param file          Path of the cache file, or NULL when disabled.
+ * @param map           Read-only mapping of the file as it was when opened.
+ * @param size          Size of the mapping.
+ * @param entries       First entry line inside the mapping.
+ * @param fd            Descriptor used to append new entries, or -1.
+ */
+typedef struct s_cache
+{
+	char	*file;
+	char	*map;
+	size_t	size;
+	char	*entries;
+	int		fd;
+}		t_cache;
+
+/**
+ * Record returned by the getdents64 system call.
+ *
+ * Members:
+ * @param d_ino         Inode number.
+ * @param d_off         Offset of the next record.
+ * @param d_reclen      Size of this record.
+ * @param d_type        File type, DT_UNKNOWN on some file systems.
+ * @param d_name        Null-terminated file name.
+ */
+typedef struct s_dirent64
+{
+	unsigned long	d_ino;
+	long			d_off;
+	unsigned short	d_reclen;
+	unsigned char	d_type;
+	char			d_name[];
+}		t_dirent64;
+
+/**
+ * Slot of the PATH index hash set.
+ *
+ * Members:
+ * @param name          File name, pointing into the directory buffer.
+ * @param dir           Index of the first PATH directory holding the name.
+ */
+typedef struct s_slot
+{
+	char	*name;
+	int		dir;
+}		t_slot;
+
+/**
+ * Hash set of the file names found in the PATH directories.
+ *
+ * Built with one getdents64 scan per directory when resolving the pipeline
+ * would otherwise cost at least PATH_INDEX_PROBES `access` calls.
+ *
+ * Members:
+ * @param slots         Open addressing table, a power of two in size.
+ * @param size          Number of slots.
+ * @param count         Number of names stored.
+ * @param bufs          Directory listings the names point into, one per dir.
+ * @param fds           Descriptors of the PATH directories, or -1.
+ * @param dirs          Number of PATH directories.
+ * @param partial       Non-zero if a directory could not be listed, in which
+ *                      case a name missing from the set is probed as usual.
+ */
+typedef struct s_index
+{
+	t_slot	*slots;
+	size_t	size;
+	size_t	count;
+	char	**bufs;
+	int		*fds;
+	int		dirs;
+	int		partial;
+}		t_index;
+
+/**
+ * Entry of the builtin registry consulted before a command is resolved.
+ *
+ * Members:
+ * @param name          Command name the builtin replaces.
+ * @param accepts       Returns non-zero if the builtin supports the given
+ *                      arguments exactly like the external command does.
+ * @param run           Runs the command on STDIN and STDOUT and returns its
+ *                      exit status.
+ */
+typedef struct s_builtin
+{
+	char	*name;
+	int		(*accepts)(char **argv);
+	int		(*run)(char **argv);
+}		t_builtin;
+
+/**
+ * Helper process forked ahead of the stages with --zygotes, see
+ * `start_zygotes`, or a stage a helper started, see `zygote_main`.
+ *
+ * Members:
+ * @param pid           Process ID of the helper or of the stage, or 0 if
+ *                      the helper could not be forked.
+ * @param sock          Socket the helper receives stages on, or the one the
+ *                      wait status of the stage is sent on, or -1.
+ */
+typedef struct s_zygote
+{
+	pid_t	pid;
+	int		sock;
+}		t_zygote;
+
+/**
+ * Message a helper sends back for a stage it started, once with only the
+ * process ID of the stage, then once the stage exited.
+ *
+ * Members:
+ * @param pid           Process ID of the stage, or -1 if it could not be
+ *                      forked.
+ * @param status        Wait status of the stage.
+ * @param usage         Resources used by the stage, filled by `wait4`.
+ */
+typedef struct s_zygote_reply
+{
+	pid_t			pid;
+	int				status;
+	struct rusage	usage;
+}		t_zygote_reply;
+
 /**
  * Structure representing the data used in the pipex program.
  *
@@ -34,8 +723,8 @@
  * It includes environment variables, command-line arguments, file descriptors
  * for input and output, a heredoc flag, and details necessary for managing
  * commands and inter-process communication. The structure holds the number of
- * commands, an array for pipe file descriptors, an array of process IDs, and
- * the current child process status.
+ * commands, an array for pipe file descriptors, an array of process IDs, the
+ * resolved stages and the current child process status.
  *
  * Members:
  * @param envp          Array of environment variable strings.
@@ -44,42 +733,621 @@
  * @param heredoc_flag  Flag indicating 'here_doc' functionality.
  * @param input_fd      File descriptor for input file.
  * @param output_fd     File descriptor for output file.
- * @param pipe          Array of file descriptors for pipes.
+ * @param pipe          Array of file descriptors for pipes, NULL with
+ *                      --jit-pipes.
+ * @param prev_read     With --jit-pipes, read end of the pipe written by the
+ *                      previous stage, or -1.
+ * @param next_pipe     With --jit-pipes, pipe the current stage writes to, or
+ *                      -1 for both ends.
+ * @param cmds          Command strings of the pipeline, one per stage.
  * @param cmd_count     Number of commands to be executed.
  * @param child         Index of the current child process.
  * @param pids          Array of process IDs.
- * @param cmd_options   Array of command options.
- * @param cmd_path      Path to the command executable.
+ * @param start         CLOCK_MONOTONIC time in ms the first stage started.
+ * @param meters        Shared array of one t_meter per pipe with --meter,
+ *                      NULL otherwise.
+ * @param merge_pid     Process ID of the process merging the inputs of
+ *                      --input, or 0.
+ * @param feeder_pid    Process ID of the process reading the here_doc body
+ *                      with --heredoc-stream, or 0.
+ * @param helper_status Exit code of the first --tee branch, --input pipeline
+ *                      or here_doc feeder that failed, or 0, see
+ *                      `record_helper`.
+ * @param zygotes       Helpers forked with --zygotes, or NULL.
+ * @param zygote_count  Number of helpers in `zygotes`.
+ * @param paths         Directories of PATH, each ending in '/', parsed once.
+ * @param stages        Array of resolved stages, one per command.
+ * @param cache         Command resolution cache, used with --cache.
+ * @param index         Index of the PATH directories, built on demand.
+ * @param memo          Commands resolved so far, a list of t_memo. Shared
+ *                      by every pipeline of a --batch manifest.
+ * @param opts          Options parsed from the command line.
  */
 typedef struct s_data
 {
-	char	**envp;
-	char	**av;
-	int		ac;
-	int		heredoc_flag;
-	int		input_fd;
-	int		output_fd;
-	int		*pipe;
-	int		cmd_count;
-	int		child;
-	int		*pids;
-	char	**cmd_options;
-	char	*cmd_path;
+	char		**envp;
+	char		**av;
+	int			ac;
+	int			heredoc_flag;
+	int			input_fd;
+	int			output_fd;
+	int			*pipe;
+	int			prev_read;
+	int			next_pipe[2];
+	char		**cmds;
+	int			cmd_count;
+	int			child;
+	int			*pids;
+	long		start;
+	t_meter		*meters;
+	pid_t		merge_pid;
+	pid_t		feeder_pid;
+	int			helper_status;
+	t_zygote	*zygotes;
+	int			zygote_count;
+	char		**paths;
+	t_stage		*stages;
+	t_cache		cache;
+	t_index		index;
+	t_list		*memo;
+	t_opts		opts;
 }		t_data;
 
+/**
+ * Command resolved by `resolve_cmd`, so that it is looked up once.
+ *
+ * Members:
+ * @param cmd           Name of the command as given.
+ * @param path          Its full path, or NULL if it was not found.
+ */
+typedef struct s_memo
+{
+	char	*cmd;
+	char	*path;
+}		t_memo;
+
+/**
+ * Pipeline of a --batch manifest.
+ *
+ * Members:
+ * @param line          Line of the manifest it was read from.
+ * @param av            Argument vector of the pipeline, as if given on the
+ *                      command line: "pipex", infile, commands, outfile.
+ * @param ac            Count of arguments in `av`.
+ * @param pid           Process ID of the process running it, or 0.
+ * @param status        Its wait status, or -1 while it did not exit.
+ * @param started       CLOCK_MONOTONIC time in us it was started.
+ * @param ended         CLOCK_MONOTONIC time in us it was reaped.
+ * @param usage         Resources it used, its stages included.
+ */
+typedef struct s_job
+{
+	int				line;
+	char			**av;
+	int				ac;
+	pid_t			pid;
+	int				status;
+	long			started;
+	long			ended;
+	struct rusage	usage;
+}		t_job;
+
+/**
+ * State of a --batch run.
+ *
+ * Members:
+ * @param tmpl          Data every pipeline starts from, holding the commands
+ *                      resolved for the whole manifest.
+ * @param jobs          Array of the pipelines of the manifest.
+ * @param count         Number of pipelines.
+ * @param next          Index of the next pipeline to start.
+ * @param running       Number of pipelines running.
+ */
+typedef struct s_batch
+{
+	t_data	tmpl;
+	t_job	*jobs;
+	int		count;
+	int		next;
+	int		running;
+}		t_batch;
+
+/**
+ * Pipeline received by a --serve run.
+ *
+ * A request is a frame sent by `submit_job`: its length as a uint32_t,
+ * sent with the input, output and error descriptors of the client as
+ * SCM_RIGHTS, followed by the working directory of the client and the
+ * commands, each ending in '\0'. The reply is the exit code of the
+ * pipeline as an int.
+ *
+ * Members:
+ * @param conn          The connection the request came on.
+ * @param fds           Input, output and error descriptors of the client.
+ * @param payload       Working directory and commands of the frame.
+ * @param av            Argument vector of the pipeline: "pipex",
+ *                      "/dev/stdin", the commands, "/dev/stdout".
+ * @param ac            Count of arguments in `av`.
+ * @param len           Length of the frame after its header, once received.
+ * @param got           Bytes of the frame received so far.
+ * @param deadline      CLOCK_MONOTONIC time in ms by which the frame must be
+ *                      complete, or 0 for a free slot of the server.
+ */
+typedef struct s_request
+{
+	int			conn;
+	int			fds[SERVE_FDS];
+	char		*payload;
+	char		**av;
+	int			ac;
+	uint32_t	len;
+	size_t		got;
+	long		deadline;
+}		t_request;
+
+/**
+ * State of a --serve run.
+ *
+ * Members:
+ * @param tmpl          Data every pipeline starts from, holding the PATH
+ *                      directories and the commands resolved so far.
+ * @param sock          The listening socket.
+ * @param watch         inotify descriptor watching the PATH directories, or
+ *                      -1.
+ * @param sfd           signalfd receiving SIGCHLD, SIGINT and SIGTERM.
+ * @param old_mask      Signal mask to restore in the pipelines.
+ * @param pending       Connections whose request is still being received,
+ *                      see `serve_accept`.
+ */
+typedef struct s_serve
+{
+	t_data		tmpl;
+	int			sock;
+	int			watch;
+	int			sfd;
+	sigset_t	old_mask;
+	t_request	pending[SERVE_PENDING];
+}		t_serve;
+
+
+/**
+ * Entry of the rule table used by `rewrite_stages`.
+ *
+ * Members:
+ * @param name          Name of the rule, for the plan printed by --print-plan.
+ * @param apply         Tries the rule on the stage at the given index. Returns
+ *                      non-zero if the pipeline was changed.
+ */
+typedef struct s_rule
+{
+	char	*name;
+	int		(*apply)(t_data *data, int i);
+}		t_rule;
+
 /*  file_handler.c */
 
+int		heredoc_read(t_data *data, t_heredoc *hd);
 void	get_input_file(t_data *data);
 void	get_output_file(t_data *data);
 
+/*  heredoc.c */
+
+int		heredoc_open(t_heredoc *hd, long spill);
+int		heredoc_write(t_heredoc *hd, char *line, size_t len);
+int		heredoc_input(t_heredoc *hd);
+
+/*  options_heredoc.c */
+
+int		set_heredoc_spill(t_opts *opts, char *value);
+int		set_heredoc_stream(t_opts *opts, char *value);
+
+/*  heredoc_stream.c */
+
+void	heredoc_stream(t_data *data);
+void	wait_feeder(t_data *data);
+
 /*  data_init.c    */
 
-t_data	init_data(int ac, char **av, char **envp);
+t_data	init_data(int ac, char **av, char **envp, t_opts *opts);
+void	setup_pipes(t_data *data);
+
+/*  options.c */
+
+int		parse_options(int ac, char **av, t_opts *opts);
+void	free_options(t_opts *opts);
+
+/*  options_set.c */
+
+int		set_launcher(t_opts *opts, char *value);
+int		set_cache(t_opts *opts, char *value);
+int		set_no_builtins(t_opts *opts, char *value);
+int		set_print_plan(t_opts *opts, char *value);
+
+/*  options_rewrite.c */
+
+int		set_rewrite(t_opts *opts, char *value);
+int		set_no_rewrite(t_opts *opts, char *value);
+
+/*  options_pipe.c */
+
+int		parse_size(char *str, int *size);
+int		set_pipe_size(t_opts *opts, char *value);
+int		set_jit_pipes(t_opts *opts, char *value);
+
+/*  options_meter.c */
+
+int		set_meter(t_opts *opts, char *value);
+
+/*  options_parallel.c */
+
+int		parse_positive(char **str, char end, long *num);
+int		set_parallel(t_opts *opts, char *value);
+
+/*  parallel.c */
+
+void	plan_workers(t_data *data);
+int		run_parallel(t_stage *stage, int count, char **envp);
+
+/*  parallel_chunk.c */
+
+ssize_t	next_chunk(t_parallel *par);
+int		take_chunk(t_parallel *par, int fd, size_t len);
+
+/*  parallel_worker.c */
+
+int		start_worker(t_parallel *par, t_worker *slot, size_t len);
+int		finish_worker(t_parallel *par, t_worker *slot);
+
+/*  options_tee.c */
+
+int		set_tee(t_opts *opts, char *value);
+
+/*  options_input.c */
+
+int		set_input(t_opts *opts, char *value);
+int		set_merge(t_opts *opts, char *value);
+
+/*  options_batch.c */
+
+int		set_batch(t_opts *opts, char *value);
+int		set_jobs(t_opts *opts, char *value);
+
+/*  job.c */
+
+void	job_resolve(t_data *tmpl, int ac, char **av);
+int		job_run(t_data *tmpl, int ac, char **av);
+
+/*  batch.c */
+
+int		run_batch(t_opts *opts, int extra, char **envp);
+
+/*  batch_manifest.c */
+
+int		read_manifest(t_batch *batch, char *path);
+void	free_jobs(t_batch *batch);
+
+/*  batch_fields.c */
+
+char	**split_fields(char *text);
+
+/*  batch_report.c */
+
+void	print_batch(t_batch *batch);
+int		batch_exit_code(t_batch *batch);
+
+/*  options_serve.c */
+
+int		set_serve(t_opts *opts, char *value);
+int		set_submit(t_opts *opts, char *value);
+int		check_submit(t_opts *opts);
+
+/*  serve.c */
+
+int		run_serve(t_opts *opts, int extra, char **envp);
+
+/*  serve_setup.c */
+
+int		serve_init(t_serve *serve, t_opts *opts, char **envp);
+void	watch_paths(t_serve *serve);
+void	refresh_paths(t_serve *serve);
+void	serve_close(t_serve *serve);
+
+/*  serve_conn.c */
+
+void	serve_accept(t_serve *serve);
+int		serve_expire(t_serve *serve);
+void	serve_pollfds(t_serve *serve, struct pollfd *pfd);
+
+/*  serve_request.c */
+
+int		recv_request(t_request *req);
+void	free_request(t_request *req);
+
+/*  submit.c */
+
+int		submit_job(t_opts *opts, int ac, char **av);
+
+/*  subpipeline.c */
+
+void	exec_subpipeline(t_data *data, char *infile, char *cmds,
+			char *outfile);
+
+/*  merge.c */
+
+void	setup_merge(t_data *data);
+void	wait_merge(t_data *data);
+
+/*  merge_input.c */
+
+t_source	*open_sources(t_data *data, int *count);
+
+/*  merge_policy.c */
+
+int		merge_concat(t_source *src, int count);
+int		merge_interleave(t_source *src, int count);
+int		merge_sorted(t_source *src, int count);
+
+/*  line_reader.c */
+
+int		reader_init(t_reader *reader, int fd);
+ssize_t	reader_line(t_reader *reader, char **line);
+void	reader_free(t_reader *reader);
+
+/*  tee.c */
+
+void	tee_edge(t_data *data, int edge, int *fds);
+void	tee_output(t_data *data);
+void	wait_tees(t_data *data);
+
+/*  tee_relay.c */
+
+void	tee_process(t_data *data, t_tee *tee, int in, int out);
 
-/*  env_parsing.c   */
+/*  meter.c */
 
+void	setup_meters(t_data *data);
+void	meter_edge(t_data *data, int edge, int *fds);
+void	wait_meters(t_data *data);
+void	free_meters(t_data *data);
+
+/*  meter_relay.c */
+
+void	relay_process(t_data *data, t_meter *meter, int in, int out);
+
+/*  meter_report.c */
+
+void	print_meters(t_data *data);
+
+/*  pipe_size.c */
+
+void	apply_pipe_size(t_data *data, int edge, int *fds);
+
+/*  options_report.c */
+
+int		set_pipestatus(t_opts *opts, char *value);
+int		set_pipestatus_json(t_opts *opts, char *value);
+int		set_stats(t_opts *opts, char *value);
+
+/*  options_time.c */
+
+int		set_timeout(t_opts *opts, char *value);
+int		set_stage_timeout(t_opts *opts, char *value);
+int		set_kill_after(t_opts *opts, char *value);
+
+/*  jit_pipes.c */
+
+void	open_next_pipe(t_data *data);
+void	close_prev_pipe(t_data *data);
+
+/*  options_zygote.c */
+
+int		set_zygotes(t_opts *opts, char *value);
+
+/*  zygote.c */
+
+void	start_zygotes(t_data *data);
+int		refill_zygote(t_data *data, pid_t pid);
+void	free_zygotes(t_data *data);
+
+/*  zygote_exec.c */
+
+void	zygote_payload(t_stage *stage, t_strbuf *sb);
+pid_t	zygote_exec(t_data *data, int in, int out);
+void	wait_remote(t_data *data, int i);
+int		watch_remotes(t_data *data, int epfd);
+
+/*  zygote_helper.c */
+
+int		zygote_request(t_data *data, char *buf, t_zygote *child);
+
+/*  zygote_loop.c */
+
+void	zygote_main(t_data *data, int sock);
+
+/*  options_placement.c */
+
+int		set_cpu_placement(t_opts *opts, char *value);
+int		set_cpus(t_opts *opts, char *value);
+
+/*  placement.c */
+
+void	plan_placement(t_data *data);
+void	apply_placement(t_stage *stage);
+
+/*  topology.c */
+
+int		*cpu_order(int *count);
+
+/*  options_priority.c */
+
+int		set_nice(t_opts *opts, char *value);
+int		set_sched(t_opts *opts, char *value);
+int		set_ioprio(t_opts *opts, char *value);
+
+/*  priority.c */
+
+void	plan_priorities(t_data *data);
+void	apply_priorities(t_stage *stage);
+
+/*  launcher.c */
+
+void	stage_io(t_data *data, int *in, int *out);
+void	launch_stages(t_data *data);
+
+/*  child_process.c */
+
+void	close_inherited(t_data *data);
+void	execute_child_process(t_data *data, int in, int out);
+
+/*  parse_envp.c   */
+
+char	**get_env_paths(char **envp);
+char	*resolve_cmd(char *cmd, t_data *data);
 char	*get_cmd(char *cmd, t_data *data);
 
+/*  memo.c */
+
+int		memo_lookup(t_data *data, char *cmd, char **path);
+void	memo_store(t_data *data, char *cmd, char *path);
+void	memo_free(t_data *data);
+
+/*  cache.c */
+
+void	cache_open(t_data *data);
+void	cache_close(t_data *data);
+
+/*  cache_entry.c */
+
+char	*cache_lookup(t_data *data, char *cmd, int *hit);
+void	cache_store(t_data *data, char *cmd, char *path);
+
+/*  cache_utils.c */
+
+char	*cache_file_name(char *path_var);
+int		cache_write_dir(int fd, char *dir);
+int		cache_dir_matches(char *line, char *end);
+
+/*  path_index.c */
+
+int		path_index_find(t_data *data, char *cmd, char **cmd_path);
+
+/*  path_index_set.c */
+
+int		index_insert(t_index *index, char *name, int dir);
+t_slot	*index_lookup(t_index *index, char *name);
+void	path_index_free(t_data *data);
+
+/*  builtins.c */
+
+const t_builtin	*find_builtin(char **argv);
+int		write_all(int fd, char *buf, size_t len);
+int		builtin_copy(int in, int out);
+int		builtin_put_count(unsigned long count);
+
+/*  builtin_cat.c */
+
+int		cat_accepts(char **argv);
+int		builtin_cat(char **argv);
+int		builtin_copy_file(char **argv);
+
+/*  builtin_head.c */
+
+int		head_accepts(char **argv);
+int		builtin_head(char **argv);
+
+/*  builtin_wc.c */
+
+int		wc_accepts(char **argv);
+int		builtin_wc(char **argv);
+
+/*  plan.c */
+
+void	plan_stages(t_data *data);
+void	free_stages(t_data *data);
+
+/*  plan_check.c */
+
+void	check_plan(t_data *d);
+
+/*  rewrite.c */
+
+void	rewrite_stages(t_data *data);
+void	print_plan(t_data *data);
+
+/*  rewrite_rules.c */
+
+int		rule_leading_cat(t_data *data, int i);
+int		rule_cat_cat(t_data *data, int i);
+int		rule_copy(t_data *data, int i);
+
+/*  reaper.c */
+
+void	reap_ready(t_data *data);
+int		stages_left(t_data *data);
+void	reap_stages(t_data *data);
+
+/*  reaper_setup.c */
+
+void	arm_timer(t_data *data, t_reaper *reaper);
+int		reaper_open(t_data *data, t_reaper *reaper);
+void	reaper_close(t_data *data, t_reaper *reaper);
+
+/*  reaper_pidfd.c */
+
+void	close_pidfds(t_data *data);
+int		watch_pidfds(t_data *data, int epfd);
+void	reap_stage(t_data *data, int i);
+void	signal_stage(t_data *data, int i, int sig);
+
+/*  deadline.c */
+
+long	now_ms(void);
+void	set_deadline(t_data *data, int i);
+long	next_wake(t_data *data);
+void	expire_stages(t_data *data);
+
+/*  pipestatus.c */
+
+int		stage_exit_code(t_stage *stage);
+int		pipeline_exit_code(t_data *data);
+void	record_helper(t_data *data, int status);
+void	print_pipestatus(t_data *data);
+
+/*  pipestatus_json.c */
+
+void	add_argv_json(t_strbuf *sb, char **argv);
+void	write_report(t_strbuf *sb, char *path);
+void	write_pipestatus_json(t_data *data, int exit_code);
+
+/*  stats.c */
+
+long	now_us(void);
+long	timeval_us(struct timeval *tv);
+long	stage_wall_us(t_stage *stage);
+void	stage_exited(t_stage *stage, int status, struct rusage *usage);
+void	wait_stage(t_data *data, int i);
+
+/*  stats_report.c */
+
+void	add_col(t_strbuf *sb, long num, int width);
+void	print_stats(t_data *data);
+
+/*  stats_json.c */
+
+void	write_stats_json(t_data *data);
+
+/*  strbuf.c */
+
+void	sb_add_len(t_strbuf *sb, const char *str, size_t len);
+void	sb_add(t_strbuf *sb, const char *str);
+void	sb_add_num(t_strbuf *sb, long num);
+void	sb_add_json(t_strbuf *sb, const char *str);
+int		sb_flush(t_strbuf *sb, int fd);
+
+/*  pipex.c */
+
+int		pipex(t_data *d);
+
 /*  pipex_utils.c */
 
 void	cleanup_n_exit(int error_status, t_data *data);
@@ -0,0 +1,171 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:12:40 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Resolves every command of the manifest once, before any pipeline starts.
+ *
+ * Every pipeline forked afterwards inherits the commands resolved in the
+ * template data, so a command shared by many pipelines is looked up in PATH
+ * a single time, see `job_resolve`.
+ *
+ * @param[in,out] batch The batch.
+ */
+static void	resolve_jobs(t_batch *batch)
+{
+	int	i;
+
+	i = 0;
+	while (i < batch->count)
+	{
+		job_resolve(&batch->tmpl, batch->jobs[i].ac, batch->jobs[i].av);
+		i++;
+	}
+}
+
+/**
+ * Prepares a batch: reads the manifest, sizes the pool, resolves the
+ * commands and forks the helpers of --zygotes, shared by every pipeline.
+ *
+ * Without --jobs as many pipelines run at once as there are CPUs the
+ * process may run on, so that every core is kept busy while the pipelines
+ * do not compete for the same core.
+ *
+ * @param[out] batch The batch.
+ * @param[in] opts Options parsed from the command line.
+ * @param[in] envp The environment variables.
+ * @return 0 on success, 1 if the manifest could not be read.
+ */
+static int	init_batch(t_batch *batch, t_opts *opts, char **envp)
+{
+	cpu_set_t	cpus;
+
+	ft_bzero(batch, sizeof(*batch));
+	batch->tmpl.envp = envp;
+	batch->tmpl.opts = *opts;
+	batch->tmpl.cache.fd = -1;
+	if (!opts->jobs && sched_getaffinity(0, sizeof(cpus), &cpus) == 0)
+		batch->tmpl.opts.jobs = CPU_COUNT(&cpus);
+	if (batch->tmpl.opts.jobs < 1)
+		batch->tmpl.opts.jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	if (batch->tmpl.opts.jobs < 1)
+		batch->tmpl.opts.jobs = 1;
+	if (read_manifest(batch, opts->batch))
+		return (1);
+	if (opts->cache)
+		cache_open(&batch->tmpl);
+	resolve_jobs(batch);
+	start_zygotes(&batch->tmpl);
+	return (0);
+}
+
+/**
+ * Starts a pipeline of the manifest in a process of its own.
+ *
+ * The process runs the pipeline from the template data of the batch, see
+ * `job_run`, and exits with the exit code of the pipeline.
+ *
+ * @param[in,out] batch The batch.
+ * @param[in,out] job The pipeline.
+ */
+static void	start_job(t_batch *batch, t_job *job)
+{
+	int	exit_code;
+
+	job->started = now_us();
+	job->pid = fork();
+	if (job->pid == 0)
+	{
+		exit_code = job_run(&batch->tmpl, job->ac, job->av);
+		free_jobs(batch);
+		exit(exit_code);
+	}
+	if (job->pid != -1)
+		batch->running++;
+	if (job->pid != -1)
+		return ;
+	ft_printf("pipex: fork error: %s\n", strerror(errno));
+	job->status = W_EXITCODE(ERROR, 0);
+	job->ended = job->started;
+}
+
+/**
+ * Waits for any running pipeline with `wait4` and records its status and
+ * the resources it used, its stages included, except those started by the
+ * helpers of --zygotes. A helper that exited is replaced instead.
+ *
+ * @param[in,out] batch The batch.
+ */
+static void	reap_job(t_batch *batch)
+{
+	struct rusage	usage;
+	pid_t			pid;
+	int				status;
+	int				i;
+
+	pid = wait4(-1, &status, 0, &usage);
+	if (pid == -1 && errno != EINTR)
+		batch->running = 0;
+	if (refill_zygote(&batch->tmpl, pid))
+		return ;
+	i = 0;
+	while (pid > 0 && i < batch->count && batch->jobs[i].pid != pid)
+		i++;
+	if (pid <= 0 || i == batch->count)
+		return ;
+	batch->jobs[i].status = status;
+	batch->jobs[i].usage = usage;
+	batch->jobs[i].ended = now_us();
+	batch->running--;
+}
+
+/**
+ * Runs the pipelines of a --batch manifest with a bounded pool of processes.
+ *
+ * The pipelines are started in the order of the manifest, a new one as soon
+ * as one of the at most --jobs running pipelines exits, then a summary of
+ * every pipeline is printed, see `print_batch`.
+ *
+ * @param[in,out] opts Options parsed from the command line, freed.
+ * @param[in] extra Number of pipeline arguments after the options, which
+ *                  --batch does not take.
+ * @param[in] envp The environment variables.
+ * @return 0 if every pipeline exited with 0, 1 otherwise.
+ */
+int	run_batch(t_opts *opts, int extra, char **envp)
+{
+	t_batch	batch;
+	int		exit_code;
+
+	exit_code = 1;
+	if (extra > 0)
+		ft_putendl_fd("pipex: --batch takes no pipeline arguments", 2);
+	if (extra == 0 && !init_batch(&batch, opts, envp))
+	{
+		while (batch.next < batch.count || batch.running > 0)
+		{
+			if (batch.next < batch.count
+				&& batch.running < batch.tmpl.opts.jobs)
+				start_job(&batch, &batch.jobs[batch.next++]);
+			else
+				reap_job(&batch);
+		}
+		print_batch(&batch);
+		exit_code = batch_exit_code(&batch);
+		free_jobs(&batch);
+		free_zygotes(&batch.tmpl);
+		free_stages(&batch.tmpl);
+	}
+	free_options(opts);
+	return (exit_code);
+}
@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_fields.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:44:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:44:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Copies the next field of a line of the manifest.
+ *
+ * @param[in,out] text Rest of the line, advanced past the field and the tab
+ *                     ending it.
+ * @return The field, empty if two tabs follow each other, or NULL if memory
+ *         runs out.
+ */
+static char	*next_field(char **text)
+{
+	char	*end;
+	char	*field;
+
+	end = ft_strchr(*text, '\t');
+	if (!end)
+		end = *text + ft_strlen(*text);
+	field = ft_substr(*text, 0, end - *text);
+	*text = end + (*end == '\t');
+	return (field);
+}
+
+/**
+ * Splits a line of the manifest on every tab.
+ *
+ * Unlike `ft_split`, consecutive tabs are not merged: they delimit an empty
+ * field, which `parse_job` rejects instead of silently shifting the fields
+ * after it.
+ *
+ * @param[in] text The line, without its newline.
+ * @return A NULL-terminated array of the fields, or NULL if memory runs out.
+ */
+char	**split_fields(char *text)
+{
+	char	**fields;
+	char	*s;
+	int		n;
+	int		i;
+
+	n = 1;
+	s = text;
+	while (*s)
+		n += (*s++ == '\t');
+	fields = ft_calloc(n + 1, sizeof(*fields));
+	i = 0;
+	while (fields && i < n)
+	{
+		fields[i] = next_field(&text);
+		if (!fields[i++])
+		{
+			free_array(fields);
+			return (NULL);
+		}
+	}
+	return (fields);
+}
@@ -0,0 +1,183 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_manifest.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:07:52 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:44:30 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Builds the argument vector of a pipeline from a line of the manifest.
+ *
+ * The fields of the line are separated by tabs: the infile, at least two
+ * commands and the outfile, as they would be given on the command line.
+ * Every tab ends a field, see `split_fields`, and an empty field makes the
+ * line invalid. The vector starts with "pipex" so that it can be handed to
+ * `init_data`.
+ *
+ * @param[in] text The line, without its newline.
+ * @param[out] job The pipeline, whose `av` and `ac` are set.
+ * @return 0 on success, 1 if the line is not a valid pipeline or memory
+ *         runs out.
+ */
+static int	parse_job(char *text, t_job *job)
+{
+	char	**fields;
+	int		n;
+
+	fields = split_fields(text);
+	if (!fields)
+		return (1);
+	n = 0;
+	while (fields[n] && *fields[n])
+		n++;
+	job->av = ft_calloc(n + 2, sizeof(char *));
+	if (job->av)
+		job->av[0] = ft_strdup("pipex");
+	if (n < 4 || fields[n] || !ft_strncmp(fields[0], "here_doc", 9)
+		|| !job->av || !job->av[0])
+	{
+		free_array(job->av);
+		free_array(fields);
+		job->av = NULL;
+		return (1);
+	}
+	ft_memcpy(job->av + 1, fields, n * sizeof(char *));
+	free(fields);
+	job->ac = n + 1;
+	return (0);
+}
+
+/**
+ * Adds the pipeline of a line of the manifest to a list.
+ *
+ * Empty lines and lines starting with '#' are skipped.
+ *
+ * @param[in,out] jobs The list of t_job to add to.
+ * @param[in] line The line, ending in a newline unless it is the last one.
+ * @param[in] len Length of the line.
+ * @param[in] line_no Number of the line, counting from 1.
+ * @return 0 on success, 1 if the line is invalid or memory runs out.
+ */
+static int	add_job(t_list **jobs, char *line, size_t len, int line_no)
+{
+	t_job	*job;
+	t_list	*node;
+	char	*text;
+
+	if (line[len - 1] == '\n')
+		len--;
+	if (len == 0 || line[0] == '#')
+		return (0);
+	text = ft_substr(line, 0, len);
+	job = ft_calloc(1, sizeof(*job));
+	node = NULL;
+	if (text && job && !parse_job(text, job))
+		node = ft_lstnew(job);
+	free(text);
+	if (!node && job)
+		free_array(job->av);
+	if (!node)
+		free(job);
+	if (!node)
+		return (1);
+	job->line = line_no;
+	job->status = -1;
+	ft_lstadd_back(jobs, node);
+	return (0);
+}
+
+/**
+ * Moves the pipelines of a list into the array of a batch.
+ *
+ * @param[out] batch The batch, whose `jobs` and `count` are set.
+ * @param[in,out] jobs The list of t_job, freed.
+ * @return 0 on success, 1 if memory runs out.
+ */
+static int	collect_jobs(t_batch *batch, t_list **jobs)
+{
+	t_list	*node;
+	int		i;
+
+	batch->count = ft_lstsize(*jobs);
+	batch->jobs = ft_calloc(batch->count + 1, sizeof(t_job));
+	node = *jobs;
+	i = 0;
+	while (batch->jobs && node)
+	{
+		batch->jobs[i++] = *(t_job *)node->content;
+		node = node->next;
+	}
+	if (batch->jobs)
+		ft_lstclear(jobs, free);
+	return (batch->jobs == NULL);
+}
+
+/**
+ * Reads the lines of the manifest into a list of pipelines.
+ *
+ * @param[in,out] reader The reader of the manifest.
+ * @param[in] path Path of the manifest, for messages.
+ * @param[in,out] jobs The list of t_job to add to.
+ * @return 0 once the whole manifest was read, non-zero on error, after a
+ *         message is printed to STDERR.
+ */
+static ssize_t	read_jobs(t_reader *reader, char *path, t_list **jobs)
+{
+	char	*line;
+	ssize_t	len;
+	int		line_no;
+
+	line_no = 0;
+	len = 1;
+	while (len > 0)
+	{
+		len = reader_line(reader, &line);
+		if (len > 0 && add_job(jobs, line, len, ++line_no))
+		{
+			ft_printf("pipex: %s:%d: invalid pipeline\n", path, line_no);
+			len = -1;
+		}
+	}
+	return (len);
+}
+
+/**
+ * Reads the manifest of a --batch run.
+ *
+ * Every line describes one pipeline, see `parse_job`. The whole manifest is
+ * read before any pipeline starts, so that a mistake on any line stops the
+ * run before it does anything.
+ *
+ * @param[out] batch The batch, whose `jobs` and `count` are set.
+ * @param[in] path Path of the manifest.
+ * @return 0 on success, 1 on error, after a message is printed to STDERR.
+ */
+int	read_manifest(t_batch *batch, char *path)
+{
+	t_reader	reader;
+	t_list		*jobs;
+	ssize_t		len;
+
+	jobs = NULL;
+	if (reader_init(&reader, open(path, O_RDONLY | O_CLOEXEC)))
+		return (1);
+	len = -1;
+	if (reader.fd < 0)
+		ft_printf("pipex: %s: %s\n", path, strerror(errno));
+	else
+		len = read_jobs(&reader, path, &jobs);
+	reader_free(&reader);
+	if (collect_jobs(batch, &jobs) || len != 0)
+	{
+		free_jobs(batch);
+		return (1);
+	}
+	return (0);
+}
@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_report.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:16:05 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 19:16:05 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Returns the exit code of a pipeline of the manifest, like the shell would
+ * report it.
+ *
+ * @param[in] job The pipeline.
+ * @return Its exit code, 128 plus the signal if it was killed, or -1 if it
+ *         did not exit.
+ */
+static int	job_exit_code(t_job *job)
+{
+	if (job->status == -1)
+		return (-1);
+	if (WIFEXITED(job->status))
+		return (WEXITSTATUS(job->status));
+	if (WIFSIGNALED(job->status))
+		return (128 + WTERMSIG(job->status));
+	return (-1);
+}
+
+/**
+ * Appends the row of one pipeline to the summary of `print_batch`.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] job The pipeline.
+ * @param[in] i Index of the pipeline.
+ */
+static void	add_job_row(t_strbuf *sb, t_job *job, int i)
+{
+	int	j;
+
+	add_col(sb, i + 1, 5);
+	add_col(sb, job->line, 5);
+	add_col(sb, job_exit_code(job), 6);
+	add_col(sb, job->ended - job->started, 11);
+	add_col(sb, timeval_us(&job->usage.ru_utime), 11);
+	add_col(sb, timeval_us(&job->usage.ru_stime), 11);
+	add_col(sb, job->usage.ru_maxrss, 10);
+	sb_add(sb, " < ");
+	sb_add(sb, job->av[1]);
+	j = 2;
+	while (j < job->ac - 1)
+	{
+		sb_add(sb, " ");
+		if (j > 2)
+			sb_add(sb, "| ");
+		sb_add(sb, job->av[j++]);
+	}
+	sb_add(sb, " > ");
+	sb_add(sb, job->av[j]);
+	sb_add(sb, "\n");
+}
+
+/**
+ * Prints a summary of the pipelines of a --batch run to STDERR, one row per
+ * pipeline in the order of the manifest.
+ *
+ * Each row holds the line of the manifest, the exit code of the pipeline,
+ * its wall time from start to reap and the user and system CPU time used by
+ * all of its processes in us, the peak resident set size of the largest of
+ * them in KiB and the pipeline itself.
+ *
+ * @param[in] batch The batch, once every pipeline exited.
+ */
+void	print_batch(t_batch *batch)
+{
+	t_strbuf	sb;
+	int			i;
+
+	ft_bzero(&sb, sizeof(sb));
+	sb_add(&sb, "   job  line status     wall_us     user_us      sys_us"
+		"  maxrss_kb pipeline\n");
+	i = 0;
+	while (i < batch->count)
+	{
+		add_job_row(&sb, &batch->jobs[i], i);
+		i++;
+	}
+	sb_flush(&sb, STDERR_FILENO);
+}
+
+/**
+ * Returns the exit code of a --batch run.
+ *
+ * @param[in] batch The batch, once every pipeline exited.
+ * @return 0 if every pipeline exited with 0, 1 otherwise.
+ */
+int	batch_exit_code(t_batch *batch)
+{
+	int	i;
+
+	i = 0;
+	while (i < batch->count)
+	{
+		if (job_exit_code(&batch->jobs[i]) != 0)
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/**
+ * Frees the pipelines of a batch.
+ *
+ * @param[in,out] batch The batch.
+ */
+void	free_jobs(t_batch *batch)
+{
+	int	i;
+
+	i = 0;
+	while (batch->jobs && i < batch->count)
+		free_array(batch->jobs[i++].av);
+	free(batch->jobs);
+	batch->jobs = NULL;
+}
@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_cat.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:49:02 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 10:12:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Checks whether `cat` can run as a builtin.
+ *
+ * Only the forms copying STDIN are handled, "cat" and "cat -". Any file
+ * argument or option is left to the external binary.
+ *
+ * @param[in] argv Command name and arguments.
+ * @return 1 if the builtin supports the arguments, 0 otherwise.
+ */
+int	cat_accepts(char **argv)
+{
+	if (!argv[1])
+		return (1);
+	return (!ft_strncmp(argv[1], "-", 2) && !argv[2]);
+}
+
+/**
+ * Builtin `cat`: copies STDIN to STDOUT.
+ *
+ * @param[in] argv Command name and arguments, unused.
+ * @return The exit status, 0 on success and 1 on error.
+ */
+int	builtin_cat(char **argv)
+{
+	(void)argv;
+	return (builtin_copy(STDIN_FILENO, STDOUT_FILENO));
+}
+
+/**
+ * Copies STDIN to STDOUT with `copy_file_range`, used for a pipeline that
+ * only copies its input file to its output file.
+ *
+ * The copy stays in the kernel and may be offloaded to the filesystem. When
+ * either side does not support it, e.g. a pipe or files on different
+ * filesystems with an older kernel, the copy goes on with `builtin_copy`.
+ *
+ * @param[in] argv Command name and arguments, unused.
+ * @return The exit status, 0 on success and 1 on error.
+ */
+int	builtin_copy_file(char **argv)
+{
+	ssize_t	n;
+
+	(void)argv;
+	n = copy_file_range(STDIN_FILENO, NULL, STDOUT_FILENO, NULL,
+			COPY_CHUNK_SIZE, 0);
+	while (n > 0)
+		n = copy_file_range(STDIN_FILENO, NULL, STDOUT_FILENO, NULL,
+				COPY_CHUNK_SIZE, 0);
+	if (n == 0)
+		return (0);
+	if (errno == EXDEV || errno == EINVAL || errno == ENOSYS
+		|| errno == EOPNOTSUPP || errno == EBADF)
+		return (builtin_copy(STDIN_FILENO, STDOUT_FILENO));
+	return (1);
+}
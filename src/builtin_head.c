@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_head.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:55:37 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 13:55:37 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Parses a line count made of decimal digits only.
+ *
+ * @param[in] str The count as given on the command line.
+ * @return The count, or -1 if the string is empty, is not a plain decimal
+ *         number or is too long to be handled safely.
+ */
+static long	parse_count(char *str)
+{
+	long	count;
+	int		len;
+
+	count = 0;
+	len = 0;
+	while (ft_isdigit(str[len]) && len < 18)
+		count = count * 10 + (str[len++] - '0');
+	if (len == 0 || str[len] != '\0')
+		return (-1);
+	return (count);
+}
+
+/**
+ * Reads the number of lines requested from `head`.
+ *
+ * Supports "head", "head -n N", "head -nN" and the obsolete "head -N".
+ *
+ * @param[in] argv Command name and arguments.
+ * @return The number of lines, or -1 for unsupported arguments.
+ */
+static long	head_count(char **argv)
+{
+	if (!argv[1])
+		return (10);
+	if (!ft_strncmp(argv[1], "-n", 3) && argv[2] && !argv[3])
+		return (parse_count(argv[2]));
+	if (argv[2] || argv[1][0] != '-')
+		return (-1);
+	if (argv[1][1] == 'n')
+		return (parse_count(argv[1] + 2));
+	return (parse_count(argv[1] + 1));
+}
+
+/**
+ * Checks whether `head` can run as a builtin.
+ *
+ * @param[in] argv Command name and arguments.
+ * @return 1 if the builtin supports the arguments, 0 otherwise.
+ */
+int	head_accepts(char **argv)
+{
+	return (head_count(argv) >= 0);
+}
+
+/**
+ * Finds how much of a chunk belongs to the requested lines.
+ *
+ * @param[in] buf The chunk read from STDIN.
+ * @param[in] n Number of bytes in the chunk.
+ * @param[in,out] lines Lines still to write, decreased for each newline used.
+ * @return Number of bytes of the chunk to write.
+ */
+static size_t	take_lines(char *buf, size_t n, long *lines)
+{
+	size_t	used;
+	char	*nl;
+
+	used = 0;
+	while (*lines > 0 && used < n)
+	{
+		nl = ft_memchr(buf + used, '\n', n - used);
+		if (!nl)
+			return (n);
+		used = nl - buf + 1;
+		(*lines)--;
+	}
+	return (used);
+}
+
+/**
+ * Builtin `head`: copies the first lines of STDIN to STDOUT.
+ *
+ * Reads in BUILTIN_BUF_SIZE chunks, finds newlines with `ft_memchr` and stops
+ * reading as soon as the requested number of lines was written.
+ *
+ * @param[in] argv Command name and arguments, accepted by `head_accepts`.
+ * @return The exit status, 0 on success and 1 on error.
+ */
+int	builtin_head(char **argv)
+{
+	char	buf[BUILTIN_BUF_SIZE];
+	long	lines;
+	ssize_t	n;
+
+	lines = head_count(argv);
+	while (lines > 0)
+	{
+		n = read(STDIN_FILENO, buf, sizeof(buf));
+		if (n <= 0)
+			return (n < 0);
+		if (write_all(STDOUT_FILENO, buf, take_lines(buf, n, &lines)))
+			return (1);
+	}
+	return (0);
+}
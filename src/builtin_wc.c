@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_wc.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 14:02:18 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 14:02:18 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Checks whether `wc` can run as a builtin.
+ *
+ * Only "wc -l" and "wc -c" are handled, which print a single count without
+ * padding when reading from STDIN.
+ *
+ * @param[in] argv Command name and arguments.
+ * @return 1 if the builtin supports the arguments, 0 otherwise.
+ */
+int	wc_accepts(char **argv)
+{
+	if (!argv[1] || argv[2])
+		return (0);
+	return (!ft_strncmp(argv[1], "-l", 3) || !ft_strncmp(argv[1], "-c", 3));
+}
+
+/**
+ * Counts the remaining bytes of STDIN when it is a regular file.
+ *
+ * @param[out] count Number of bytes between the offset and the end of file.
+ * @return 1 if the count is known without reading, 0 otherwise.
+ */
+static int	regular_size(unsigned long *count)
+{
+	struct stat	st;
+	off_t		pos;
+
+	if (fstat(STDIN_FILENO, &st) == -1 || !S_ISREG(st.st_mode))
+		return (0);
+	pos = lseek(STDIN_FILENO, 0, SEEK_CUR);
+	if (pos == -1 || pos > st.st_size)
+		return (0);
+	*count = st.st_size - pos;
+	return (1);
+}
+
+/**
+ * Builtin `wc -l` and `wc -c`: counts the newlines or bytes of STDIN.
+ *
+ * Newlines are found with `ft_memchr` over BUILTIN_BUF_SIZE chunks. For a
+ * byte count on a regular file the size is taken from `fstat` without
+ * reading the file.
+ *
+ * @param[in] argv Command name and arguments, accepted by `wc_accepts`.
+ * @return The exit status, 0 on success and 1 on error.
+ */
+int	builtin_wc(char **argv)
+{
+	char			buf[BUILTIN_BUF_SIZE];
+	unsigned long	count;
+	ssize_t			n;
+	char			*p;
+
+	count = 0;
+	if (argv[1][1] == 'c' && regular_size(&count))
+		return (builtin_put_count(count));
+	n = read(STDIN_FILENO, buf, sizeof(buf));
+	while (n > 0)
+	{
+		if (argv[1][1] == 'c')
+			count += n;
+		p = ft_memchr(buf, '\n', n);
+		while (argv[1][1] == 'l' && p)
+		{
+			count++;
+			p = ft_memchr(p + 1, '\n', buf + n - p - 1);
+		}
+		n = read(STDIN_FILENO, buf, sizeof(buf));
+	}
+	if (n < 0)
+		return (1);
+	return (builtin_put_count(count));
+}
@@ -0,0 +1,142 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtins.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:41:50 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 13:41:50 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Returns the registry of builtin commands.
+ *
+ * Each entry replaces an external command when its `accepts` function agrees
+ * to handle the arguments. New builtins are added here. The table ends with a
+ * NULL name.
+ *
+ * @return Pointer to the static builtin table.
+ */
+static const t_builtin	*builtin_table(void)
+{
+	static const t_builtin	table[] = {
+	{"cat", cat_accepts, builtin_cat},
+	{"head", head_accepts, builtin_head},
+	{"wc", wc_accepts, builtin_wc},
+	{NULL, NULL, NULL}
+	};
+
+	return (table);
+}
+
+/**
+ * Finds the builtin able to run a command.
+ *
+ * A stage matching a builtin is run by a forked child that calls the
+ * builtin directly, without `execve` and without loading a binary, which
+ * takes its startup time from milliseconds to microseconds. Arguments a
+ * builtin does not support leave the command to its external binary.
+ *
+ * @param[in] argv Command name and arguments of the stage.
+ * @return The matching registry entry, or NULL if none applies.
+ */
+const t_builtin	*find_builtin(char **argv)
+{
+	const t_builtin	*builtin;
+
+	builtin = builtin_table();
+	while (argv[0] && builtin->name)
+	{
+		if (!ft_strncmp(argv[0], builtin->name, ft_strlen(builtin->name) + 1)
+			&& builtin->accepts(argv))
+			return (builtin);
+		builtin++;
+	}
+	return (NULL);
+}
+
+/**
+ * Writes a whole buffer, retrying after short writes.
+ *
+ * @param[in] fd Descriptor to write to.
+ * @param[in] buf Data to write.
+ * @param[in] len Number of bytes to write.
+ * @return 0 on success, 1 on error.
+ */
+int	write_all(int fd, char *buf, size_t len)
+{
+	ssize_t	n;
+
+	while (len > 0)
+	{
+		n = write(fd, buf, len);
+		if (n < 0)
+			return (1);
+		buf += n;
+		len -= n;
+	}
+	return (0);
+}
+
+/**
+ * Copies everything from one descriptor to another.
+ *
+ * Data is moved with `splice` while one side is a pipe, which is always the
+ * case inside a pipeline, so it never crosses into user space. When `splice`
+ * cannot be used on the descriptors the copy falls back to `read` and
+ * `write`.
+ *
+ * @param[in] in Descriptor to read from.
+ * @param[in] out Descriptor to write to.
+ * @return 0 on success, 1 on error.
+ */
+int	builtin_copy(int in, int out)
+{
+	char	buf[BUILTIN_BUF_SIZE];
+	ssize_t	n;
+
+	n = splice(in, NULL, out, NULL, BUILTIN_BUF_SIZE, SPLICE_F_MOVE);
+	while (n > 0)
+		n = splice(in, NULL, out, NULL, BUILTIN_BUF_SIZE, SPLICE_F_MOVE);
+	if (n == 0)
+		return (0);
+	if (errno != EINVAL)
+		return (1);
+	n = read(in, buf, sizeof(buf));
+	while (n > 0)
+	{
+		if (write_all(out, buf, n))
+			return (1);
+		n = read(in, buf, sizeof(buf));
+	}
+	return (n < 0);
+}
+
+/**
+ * Prints a count followed by a newline on STDOUT, like `wc` does for a
+ * single count read from STDIN.
+ *
+ * @param[in] count The count to print.
+ * @return 0 on success, 1 on error.
+ */
+int	builtin_put_count(unsigned long count)
+{
+	char	*num;
+	char	*line;
+	int		ret;
+
+	num = ft_uitoa_base(count, 10, 'x');
+	line = NULL;
+	if (num)
+		line = ft_strjoin(num, "\n");
+	free(num);
+	if (!line)
+		return (1);
+	ret = write_all(STDOUT_FILENO, line, ft_strlen(line));
+	free(line);
+	return (ret);
+}
@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cache.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:44:26 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 11:44:26 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Checks that a mapped cache file belongs to the current PATH.
+ *
+ * The file must start with CACHE_MAGIC and a "P <PATH>" line matching the
+ * current value, followed by the directory lines written by
+ * `cache_write_dir`. Every directory must still have its recorded mtime. On
+ * success `cache->entries` points to the first entry line.
+ *
+ * @param[in,out] cache The cache, with the file mapped.
+ * @param[in] path_var Value of the PATH variable.
+ * @return 1 if the file can be used, 0 if it must be rebuilt.
+ */
+static int	cache_is_valid(t_cache *cache, char *path_var)
+{
+	char	*p;
+	char	*end;
+	char	*nl;
+	size_t	len;
+
+	p = cache->map;
+	end = cache->map + cache->size;
+	len = ft_strlen(CACHE_MAGIC);
+	if (cache->size < len || ft_strncmp(p, CACHE_MAGIC, len))
+		return (0);
+	p += len;
+	nl = ft_memchr(p, '\n', end - p);
+	if (!nl || nl - p != (long)ft_strlen(path_var) + 2
+		|| ft_strncmp(p, "P ", 2) || ft_strncmp(p + 2, path_var, nl - p - 2))
+		return (0);
+	p = nl + 1;
+	while (p < end && *p == 'D')
+	{
+		nl = ft_memchr(p, '\n', end - p);
+		if (!nl || !cache_dir_matches(p, nl))
+			return (0);
+		p = nl + 1;
+	}
+	cache->entries = p;
+	return (1);
+}
+
+/**
+ * Replaces the cache file with an empty one for the current PATH.
+ *
+ * The new header is written to a temporary file that is then renamed over
+ * the old one, so concurrent runs never read a half-written header. The
+ * directory mtimes are taken before any command is resolved, so a directory
+ * changing during the run invalidates the file on the next run.
+ *
+ * @param[in,out] cache The cache to rebuild.
+ * @param[in] path_var Value of the PATH variable.
+ */
+static void	cache_rebuild(t_cache *cache, char *path_var)
+{
+	char	**dirs;
+	char	*tmp;
+	int		fd;
+	int		i;
+
+	dirs = ft_split(path_var, ':');
+	tmp = ft_strjoin(cache->file, ".tmp");
+	fd = -1;
+	if (dirs && tmp)
+		fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+	if (fd != -1)
+	{
+		ft_putstr_fd(CACHE_MAGIC, fd);
+		ft_putstr_fd("P ", fd);
+		ft_putendl_fd(path_var, fd);
+		i = 0;
+		while (dirs[i] && !cache_write_dir(fd, dirs[i]))
+			i++;
+		close(fd);
+		if (dirs[i] || rename(tmp, cache->file) == -1)
+			unlink(tmp);
+	}
+	free(tmp);
+	free_array(dirs);
+}
+
+/**
+ * Maps the existing cache file, if any.
+ *
+ * @param[in,out] cache The cache whose file should be mapped.
+ */
+static void	cache_map(t_cache *cache)
+{
+	struct stat	st;
+	int			fd;
+
+	fd = open(cache->file, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return ;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+	{
+		cache->map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (cache->map == MAP_FAILED)
+			cache->map = NULL;
+		else
+			cache->size = st.st_size;
+	}
+	close(fd);
+}
+
+/**
+ * Opens the command resolution cache for the current PATH.
+ *
+ * The cache file is mapped and validated. A missing, foreign or stale file is
+ * rebuilt with an empty entry list. Any error leaves the cache disabled, in
+ * which case commands are resolved through PATH as usual.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the environment
+ *                     and receiving the opened cache.
+ */
+void	cache_open(t_data *data)
+{
+	t_cache	*cache;
+	int		i;
+
+	cache = &data->cache;
+	i = 0;
+	while (data->envp[i] && ft_strncmp(data->envp[i], "PATH=", 5))
+		i++;
+	if (!data->envp[i])
+		return ;
+	cache->file = cache_file_name(data->envp[i] + 5);
+	if (!cache->file)
+		return ;
+	cache_map(cache);
+	if (!cache->map || !cache_is_valid(cache, data->envp[i] + 5))
+	{
+		if (cache->map)
+			munmap(cache->map, cache->size);
+		cache->map = NULL;
+		cache->size = 0;
+		cache_rebuild(cache, data->envp[i] + 5);
+	}
+	cache->fd = open(cache->file, O_WRONLY | O_APPEND | O_CLOEXEC);
+}
+
+/**
+ * Releases the mapping, descriptor and file name of the cache.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the cache.
+ */
+void	cache_close(t_data *data)
+{
+	if (data->cache.map)
+		munmap(data->cache.map, data->cache.size);
+	if (data->cache.fd != -1)
+		close(data->cache.fd);
+	free(data->cache.file);
+	data->cache.map = NULL;
+	data->cache.fd = -1;
+	data->cache.file = NULL;
+}
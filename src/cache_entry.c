@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cache_entry.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:52:13 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 11:52:13 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Checks whether a command name can be stored in the cache.
+ *
+ * Names containing a '/' are never looked up in PATH, and names containing a
+ * tab or a newline would break the line format of the file.
+ *
+ * @param[in] cmd The command name.
+ * @return 1 if the name can be cached, 0 otherwise.
+ */
+static int	cacheable(char *cmd)
+{
+	while (*cmd)
+	{
+		if (*cmd == '/' || *cmd == '\t' || *cmd == '\n')
+			return (0);
+		cmd++;
+	}
+	return (1);
+}
+
+/**
+ * Finds the entry line of a command in the mapped cache file.
+ *
+ * @param[in] cache The opened cache.
+ * @param[in] cmd The command name.
+ * @return Pointer to the start of the "C" or "N" line of the command, or NULL
+ *         if the command has no entry.
+ */
+static char	*find_entry(t_cache *cache, char *cmd)
+{
+	char	*p;
+	char	*end;
+	size_t	len;
+
+	len = ft_strlen(cmd);
+	p = cache->entries;
+	end = cache->map + cache->size;
+	while (p && p + len + 2 < end)
+	{
+		if ((p[0] == 'C' || p[0] == 'N') && p[1] == ' '
+			&& !ft_strncmp(p + 2, cmd, len)
+			&& ((p[0] == 'C' && p[len + 2] == '\t')
+				|| (p[0] == 'N' && p[len + 2] == '\n')))
+			return (p);
+		p = ft_memchr(p, '\n', end - p);
+		if (p)
+			p++;
+	}
+	return (NULL);
+}
+
+/**
+ * Looks a command up in the resolution cache.
+ *
+ * On a hit the command is resolved without parsing PATH or probing any
+ * directory. A negative entry is a hit too, and resolves to NULL.
+ *
+ * @param[in] data Pointer to a t_data structure holding the cache.
+ * @param[in] cmd The command name.
+ * @param[out] hit Set to 1 on a hit, 0 on a miss or when the cache is off.
+ * @return A newly allocated path for a positive hit, NULL otherwise.
+ */
+char	*cache_lookup(t_data *data, char *cmd, int *hit)
+{
+	char	*entry;
+	char	*start;
+	char	*nl;
+
+	*hit = 0;
+	if (!data->cache.map || !cacheable(cmd))
+		return (NULL);
+	entry = find_entry(&data->cache, cmd);
+	if (!entry)
+		return (NULL);
+	if (entry[0] == 'N')
+	{
+		*hit = 1;
+		return (NULL);
+	}
+	start = entry + ft_strlen(cmd) + 3;
+	nl = ft_memchr(start, '\n',
+			data->cache.map + data->cache.size - start);
+	if (!nl)
+		return (NULL);
+	*hit = 1;
+	return (ft_substr(start, 0, nl - start));
+}
+
+/**
+ * Appends the resolution of a command to the cache file.
+ *
+ * The line is built first and written with a single `write` on a descriptor
+ * opened with O_APPEND, so concurrent runs never interleave their entries.
+ *
+ * @param[in] data Pointer to a t_data structure holding the cache.
+ * @param[in] cmd The command name.
+ * @param[in] path The resolved path, or NULL if the command was not found.
+ */
+void	cache_store(t_data *data, char *cmd, char *path)
+{
+	char	*line;
+	size_t	len;
+
+	if (data->cache.fd == -1 || !cacheable(cmd))
+		return ;
+	len = ft_strlen(cmd) + 4;
+	if (path)
+		len += ft_strlen(path) + 1;
+	line = ft_calloc(len, sizeof(*line));
+	if (!line)
+		return ;
+	ft_strlcat(line, "N ", len);
+	if (path)
+		line[0] = 'C';
+	ft_strlcat(line, cmd, len);
+	if (path)
+		ft_strlcat(line, "\t", len);
+	if (path)
+		ft_strlcat(line, path, len);
+	ft_strlcat(line, "\n", len);
+	write(data->cache.fd, line, ft_strlen(line));
+	free(line);
+}
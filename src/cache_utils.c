@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cache_utils.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:31:09 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:55:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Returns the directory holding the cache files, creating it if needed.
+ *
+ * The directory is "pipex" inside $XDG_CACHE_HOME, or inside $HOME/.cache
+ * when XDG_CACHE_HOME is not set.
+ *
+ * @return A newly allocated path, or NULL if neither variable is set or the
+ *         allocation fails.
+ */
+static char	*cache_dir(void)
+{
+	char	*base;
+	char	*dir;
+
+	base = getenv("XDG_CACHE_HOME");
+	if (base && *base)
+		base = ft_strdup(base);
+	else if (getenv("HOME"))
+	{
+		base = ft_strjoin(getenv("HOME"), "/.cache");
+		if (base)
+			mkdir(base, 0700);
+	}
+	else
+		return (NULL);
+	if (!base)
+		return (NULL);
+	dir = ft_strjoin(base, "/pipex");
+	free(base);
+	if (dir)
+		mkdir(dir, 0700);
+	return (dir);
+}
+
+/**
+ * Builds the name of the cache file for a PATH value.
+ *
+ * Each PATH value gets its own file, named after the FNV-1a hash of the value.
+ * The value itself is stored in the file, so a hash collision only causes the
+ * file to be rebuilt. A PATH with a relative entry, empty entries included,
+ * resolves commands against the working directory, which the file does not
+ * record, so such a PATH gets no cache at all.
+ *
+ * @param[in] path_var Value of the PATH variable.
+ * @return A newly allocated file name, or NULL if PATH has a relative entry
+ *         or on error.
+ */
+char	*cache_file_name(char *path_var)
+{
+	unsigned long	hash;
+	t_strbuf		sb;
+	char			*dir;
+	char			*hex;
+	int				relative;
+
+	hash = 14695981039346656037UL;
+	relative = (*path_var != '/');
+	while (*path_var)
+	{
+		relative |= (*path_var == ':' && path_var[1] != '/');
+		hash = (hash ^ (unsigned char)*path_var++) * 1099511628211UL;
+	}
+	dir = cache_dir();
+	hex = ft_uitoa_base(hash, 16, 'x');
+	ft_bzero(&sb, sizeof(sb));
+	if (dir && hex && !relative)
+	{
+		sb_add(&sb, dir);
+		sb_add(&sb, "/paths-");
+		sb_add_len(&sb, hex, ft_strlen(hex) + 1);
+	}
+	free(dir);
+	free(hex);
+	return (sb.str);
+}
+
+/**
+ * Writes the header line recording the mtime of a PATH directory.
+ *
+ * A directory that cannot be stat'ed is recorded with a zero mtime, so that
+ * its later creation also invalidates the cache.
+ *
+ * @param[in] fd Descriptor of the cache file being rebuilt.
+ * @param[in] dir The directory, as written in PATH.
+ * @return 0 on success, 1 if an allocation failed.
+ */
+int	cache_write_dir(int fd, char *dir)
+{
+	struct stat	st;
+	char		*sec;
+	char		*nsec;
+
+	ft_bzero(&st, sizeof(st));
+	stat(dir, &st);
+	sec = ft_uitoa_base(st.st_mtim.tv_sec, 16, 'x');
+	nsec = ft_uitoa_base(st.st_mtim.tv_nsec, 16, 'x');
+	if (sec && nsec)
+	{
+		ft_putstr_fd("D ", fd);
+		ft_putstr_fd(sec, fd);
+		ft_putchar_fd(' ', fd);
+		ft_putstr_fd(nsec, fd);
+		ft_putchar_fd(' ', fd);
+		ft_putendl_fd(dir, fd);
+	}
+	free(sec);
+	free(nsec);
+	return (!sec || !nsec);
+}
+
+/**
+ * Reads a hexadecimal number followed by a space.
+ *
+ * @param[in,out] p Cursor into the line, moved past the number and the space.
+ * @param[in] end End of the line.
+ * @return The number read.
+ */
+static unsigned long	parse_hex(char **p, char *end)
+{
+	unsigned long	n;
+	char			*digit;
+
+	n = 0;
+	while (*p < end && **p != ' ')
+	{
+		digit = ft_strchr("0123456789abcdef", **p);
+		if (!digit || !**p)
+			return (-1UL);
+		n = n * 16 + (digit - "0123456789abcdef");
+		(*p)++;
+	}
+	if (*p < end)
+		(*p)++;
+	return (n);
+}
+
+/**
+ * Checks a directory line of the cache header against the file system.
+ *
+ * @param[in] line Start of a "D <sec> <nsec> <dir>" line.
+ * @param[in] end The newline ending the line.
+ * @return 1 if the directory still has the recorded mtime, 0 otherwise.
+ */
+int	cache_dir_matches(char *line, char *end)
+{
+	struct stat		st;
+	unsigned long	sec;
+	unsigned long	nsec;
+	char			*dir;
+
+	line += 2;
+	sec = parse_hex(&line, end);
+	nsec = parse_hex(&line, end);
+	dir = ft_substr(line, 0, end - line);
+	if (!dir)
+		return (0);
+	ft_bzero(&st, sizeof(st));
+	stat(dir, &st);
+	free(dir);
+	return ((unsigned long)st.st_mtim.tv_sec == sec
+		&& (unsigned long)st.st_mtim.tv_nsec == nsec);
+}
@@ -0,0 +1,145 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   child_process.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:20:07 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:53:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Redirects the standard input and output of a process.
+ *
+ * This function is responsible for redirecting the standard input (STDIN) and
+ * standard output (STDOUT) of a process to specified file descriptors. It uses
+ * the `dup2` system call to duplicate the given file descriptors to
+ * STDIN_FILENO and STDOUT_FILENO. If either of the input or output file
+ * descriptors is invalid (less than 0), the function will call
+ * `cleanup_n_exit` to handle the situation. Similarly, if an error occurs
+ * during the redirection process (e.g., `dup2` fails), the function will call
+ * `exit_error` with an appropriate error message or code. A descriptor that
+ * already is the standard input or output keeps its close-on-exec flag
+ * through `dup2`, so the flag is cleared explicitly in that case.
+ *
+ * @param[in] input The file descriptor to be set as the new standard input
+ *                  (STDIN_FILENO).
+ * @param[in] output The file descriptor to be set as the new standard output
+ *                   (STDOUT_FILENO).
+ * @param[in,out] data Pointer to a t_data structure for error handling and
+ *                     other purposes.
+ */
+static void	redirect_io(int input, int output, t_data *data)
+{
+	if (input < 0 || output < 0)
+		cleanup_n_exit(ERROR, data);
+	if (dup2(input, STDIN_FILENO) == -1)
+		cleanup_n_exit(ERROR, data);
+	if (dup2(output, STDOUT_FILENO) == -1)
+		cleanup_n_exit(ERROR, data);
+	if (input == STDIN_FILENO)
+		fcntl(STDIN_FILENO, F_SETFD, 0);
+	if (output == STDOUT_FILENO)
+		fcntl(STDOUT_FILENO, F_SETFD, 0);
+}
+
+/**
+ * Closes every descriptor a builtin stage or a --meter relay inherited from
+ * pipex.
+ *
+ * A builtin never executes, so close-on-exec does not apply and the pipe ends
+ * it holds would keep the other stages from seeing end of file. All of them
+ * are above STDERR, and `close_range` closes them in a single call. On
+ * kernels without it the pipes and files are closed one by one. The pipe
+ * array is released afterwards, so that `cleanup_n_exit` does not close them
+ * a second time.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the descriptors.
+ */
+void	close_inherited(t_data *data)
+{
+	if (syscall(SYS_close_range, 3, ~0U, 0) == -1)
+		close_fds(data);
+	free(data->pipe);
+	data->pipe = NULL;
+	data->input_fd = -1;
+	data->output_fd = -1;
+}
+
+/**
+ * Replaces the child with the command of its stage.
+ *
+ * When the parent opened the resolved binary with O_PATH, the child executes
+ * that descriptor with `execveat` and AT_EMPTY_PATH. The kernel then does not
+ * walk the path again, and the file that runs is the one that was resolved,
+ * even if the path changed in between. If `execveat` is not available, or
+ * fails (for instance for a script, whose interpreter cannot reopen a
+ * close-on-exec descriptor), the path is executed with `execve` instead.
+ *
+ * @param[in] stage The stage to execute.
+ * @param[in] envp Environment passed to the command.
+ * @return Only returns if both exec calls failed, with -1.
+ */
+static int	exec_stage(t_stage *stage, char **envp)
+{
+	if (stage->exec_fd != -1)
+		syscall(SYS_execveat, stage->exec_fd, "", stage->argv, envp,
+			AT_EMPTY_PATH);
+	return (execve(stage->path, stage->argv, envp));
+}
+
+/**
+ * Executes a child process in the Pipex pipeline.
+ *
+ * This function is responsible for configuring and executing a single command
+ * within the pipeline. It moves to a process group of its own, see
+ * `launch_stage`, redirects the standard input and output for the
+ * child process to the descriptors chosen by `stage_io`, pins it to the
+ * CPUs of the stage, see `apply_placement`, and sets its priorities, see
+ * `apply_priorities`. Every other
+ * descriptor of pipex is close-on-exec, so a stage that executes a command
+ * does not close anything itself, and the work per child no longer grows with
+ * the length of the pipeline. A builtin stage closes them with
+ * `close_inherited`, then runs its implementation directly and exits with its
+ * status. A stage run with --parallel does the same with `run_parallel`,
+ * which starts the workers. Other stages validate the command resolved by
+ * `plan_stages` and execute it with `exec_stage`. If that fails, it handles
+ * the error appropriately.
+ *
+ * @param[in,out] data Pointer to the `t_data` structure containing necessary
+ *                     information for the child process, including file
+ *                     descriptors, command options, and environment variables.
+ * @param[in] in File descriptor to use as the standard input of the command.
+ * @param[in] out File descriptor to use as the standard output of the command.
+ */
+void	execute_child_process(t_data *data, int in, int out)
+{
+	t_stage	*stage;
+
+	stage = &data->stages[data->child];
+	setpgid(0, 0);
+	redirect_io(in, out, data);
+	apply_placement(stage);
+	apply_priorities(stage);
+	if (stage->builtin)
+	{
+		close_inherited(data);
+		cleanup_n_exit(stage->builtin(stage->argv), data);
+	}
+	if (stage->argv == NULL || stage->path == NULL)
+		cleanup_n_exit(ERROR, data);
+	if (stage->workers)
+	{
+		close_inherited(data);
+		cleanup_n_exit(run_parallel(stage, stage->workers, data->envp), data);
+	}
+	if (exec_stage(stage, data->envp) == -1)
+	{
+		cleanup_n_exit(ERROR, data);
+		ft_printf("pipex: %s: %s\n", stage->argv[0], strerror(errno));
+	}
+}
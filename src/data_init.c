@@ -6,7 +6,7 @@
 /*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/22 00:39:33 by fde-alen          #+#    #+#             */
-/*   Updated: 2024/01/22 03:04:55 by fde-alen         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:36:00 by fde-alen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,32 +16,39 @@
  * Initializes the t_data structure with default values.
  *
  * This function is responsible for setting initial values for all fields in the
- * t_data structure. It sets pointers to NULL, file descriptors to -1, and
- * integer values to 0 or -1 as appropriate. This initialization is crucial to
+ * t_data structure. The structure is zeroed first, so every pointer is NULL
+ * and every counter 0, then the arguments, environment and options are
+ * stored and the file descriptors and indexes set to -1. This is crucial to
  * ensure that the data structure starts in a known state, preventing undefined
  * behavior from uninitialized values. The initialized structure is used to
  * manage various aspects of the pipex program, such as environment variables,
  * command arguments, file descriptors, and child process management.
  *
+ * @param[in] ac The count of command line arguments.
+ * @param[in] av Array of command line argument strings.
+ * @param[in] envp Array of environment variable strings.
+ * @param[in] opts Options parsed from the command line.
  * @return An instance of t_data structure with all fields initialized to default
  *         values.
  */
-static t_data	initialize_data(void)
+static t_data	initialize_data(int ac, char **av, char **envp, t_opts *opts)
 {
 	t_data	data;
 
-	data.envp = NULL;
-	data.ac = -1;
-	data.av = NULL;
-	data.heredoc_flag = 0;
+	ft_bzero(&data, sizeof(data));
+	data.opts = *opts;
+	data.envp = envp;
+	data.ac = ac;
+	data.av = av;
 	data.input_fd = -1;
 	data.output_fd = -1;
-	data.pipe = NULL;
+	data.prev_read = -1;
+	data.next_pipe[0] = -1;
+	data.next_pipe[1] = -1;
+	data.cmds = av + 2;
 	data.cmd_count = -1;
 	data.child = -1;
-	data.pids = NULL;
-	data.cmd_options = NULL;
-	data.cmd_path = NULL;
+	data.cache.fd = -1;
 	return (data);
 }
 
@@ -50,8 +57,13 @@ static t_data	initialize_data(void)
  *
  * This function is responsible for setting up the necessary pipes for the pipex
  * program. It iterates through the required number of pipes, which is one less
- * than the command count, and creates each pipe. The file descriptors for each
- * pipe are stored in the 'pipe' field of the t_data structure. If a pipe
+ * than the command count, and creates each pipe close-on-exec, so that a
+ * stage only keeps the two ends it duplicates onto its standard input and
+ * output once it executes its command. The file descriptors for each
+ * pipe are stored in the 'pipe' field of the t_data structure. A pipe metered
+ * with --meter is split in two by `meter_edge`, the relays of --tee branches
+ * are inserted by `tee_edge`, and the capacity requested with --pipe-size is
+ * applied right away. If a pipe
  * creation fails, the function prints an error message and exits the program
  * after performing cleanup.
  *
@@ -65,56 +77,83 @@ static void	create_pipes(t_data *data)
 	i = 0;
 	while (i < data->cmd_count - 1)
 	{
-		if (pipe(data->pipe + 2 * i) == -1)
+		if (pipe2(data->pipe + 2 * i, O_CLOEXEC) == -1)
 		{
 			ft_printf("pipex: Could not create pipe: %s\n",
 				strerror(errno));
 			cleanup_n_exit(ERROR, data);
 		}
+		meter_edge(data, i + 1, data->pipe + 2 * i);
+		tee_edge(data, i + 1, data->pipe + 2 * i);
+		apply_pipe_size(data, i + 1, data->pipe + 2 * i);
 		i++;
 	}
 }
 
+/**
+ * Allocates the process ID and pipe arrays and creates the pipes.
+ *
+ * Called once the stages are planned and rewritten, so the arrays are sized
+ * for the final number of stages rather than the number of commands given on
+ * the command line. The inputs of --input are merged in front of the first
+ * stage, the shared array of --meter is mapped, and the --tee branches of
+ * the last stage are put in front of the output file.
+ * With --jit-pipes no pipe is created here, each one is created by
+ * `open_next_pipe` while the stages are launched. The pipe array starts out
+ * filled with -1, so that a failure halfway through `create_pipes` only
+ * closes descriptors that were actually opened.
+ *
+ * @param[in,out] data Pointer to a t_data structure with the final command
+ *                     count, receiving the allocated arrays and the pipes.
+ */
+void	setup_pipes(t_data *data)
+{
+	data->pids = malloc(sizeof(*data->pids) * data->cmd_count);
+	if (!data->pids)
+	{
+		ft_printf("pipex: PID error: %s\n", strerror(errno));
+		cleanup_n_exit(ERROR, data);
+	}
+	setup_merge(data);
+	setup_meters(data);
+	tee_output(data);
+	if (data->opts.jit_pipes)
+		return ;
+	data->pipe = malloc(sizeof(*data->pipe) * 2 * (data->cmd_count - 1));
+	if (!data->pipe)
+	{
+		ft_printf("pipex: Pipe error: %s\n", strerror(errno));
+		cleanup_n_exit(ERROR, data);
+	}
+	ft_memset(data->pipe, -1, sizeof(*data->pipe) * 2 * (data->cmd_count - 1));
+	create_pipes(data);
+}
+
 /**
  * Initializes the t_data structure for the pipex program.
  *
  * This function initializes and sets up the t_data structure, which is used
  * throughout the pipex program. It stores command line arguments, environment
- * variables, and sets flags for 'here_doc' functionality. The function also
- * allocates memory for storing process IDs (pids) and pipe file descriptors,
- * handles input and output file setup, and creates the necessary pipes for
- * inter-process communication.
+ * variables, and sets flags for 'here_doc' functionality, and handles input
+ * and output file setup. The process IDs and pipes are set up later by
+ * `setup_pipes`, once the pipeline is planned.
  *
  * @param[in] ac The count of command line arguments.
  * @param[in] av Array of command line argument strings.
  * @param[in] envp Array of environment variable strings.
+ * @param[in] opts Options parsed from the command line.
  * @return An initialized t_data structure.
  */
-t_data	init_data(int ac, char **av, char **envp)
+t_data	init_data(int ac, char **av, char **envp, t_opts *opts)
 {
 	t_data	data;
 
-	data = initialize_data();
-	data.envp = envp;
-	data.ac = ac;
-	data.av = av;
+	data = initialize_data(ac, av, envp, opts);
 	if (!ft_strncmp("here_doc", av[1], 9))
 		data.heredoc_flag = 1;
 	get_input_file(&data);
 	get_output_file(&data);
+	data.cmds += data.heredoc_flag;
 	data.cmd_count = ac - 3 - data.heredoc_flag;
-	data.pids = malloc(sizeof(*data.pids) * data.cmd_count);
-	if (!data.pids)
-	{
-		ft_printf("pipex: PID error: %s\n", strerror(errno));
-		cleanup_n_exit(ERROR, &data);
-	}
-	data.pipe = malloc(sizeof(*data.pipe) * 2 * (data.cmd_count - 1));
-	if (!data.pipe)
-	{
-		ft_printf("pipex: Pipe error: %s\n", strerror(errno));
-		cleanup_n_exit(ERROR, &data);
-	}
-	create_pipes(&data);
 	return (data);
 }
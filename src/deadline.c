@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deadline.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:50:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 13:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Returns the current CLOCK_MONOTONIC time in ms.
+ *
+ * @return The time in ms.
+ */
+long	now_ms(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+/**
+ * Looks up the time limit given with --stage-timeout for a stage.
+ *
+ * @param[in] data Pointer to the t_data structure holding the options.
+ * @param[in] stage Number of the stage, counting from 1.
+ * @return The limit in ms, or 0 if the stage has none.
+ */
+static long	stage_timeout(t_data *data, int stage)
+{
+	t_list			*node;
+	t_stage_value	*limit;
+	long			all;
+	long			own;
+
+	all = 0;
+	own = 0;
+	node = data->opts.stage_timeouts;
+	while (node)
+	{
+		limit = node->content;
+		if (limit->stage == stage)
+			own = limit->value;
+		else if (limit->stage == 0)
+			all = limit->value;
+		node = node->next;
+	}
+	if (own)
+		return (own);
+	return (all);
+}
+
+/**
+ * Sets the deadline of a stage that was just launched.
+ *
+ * The deadline is the earliest of the end of its own limit, counted from now,
+ * and the end of the --timeout limit, counted from the start of the first
+ * stage.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage.
+ */
+void	set_deadline(t_data *data, int i)
+{
+	long	limit;
+	long	deadline;
+
+	deadline = 0;
+	limit = stage_timeout(data, i + 1);
+	if (limit)
+		deadline = now_ms() + limit;
+	if (data->opts.timeout
+		&& (!deadline || data->start + data->opts.timeout < deadline))
+		deadline = data->start + data->opts.timeout;
+	data->stages[i].deadline = deadline;
+}
+
+/**
+ * Finds the next time a stage still running must be signaled.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ * @return The time in ms, or 0 if no stage has a pending deadline.
+ */
+long	next_wake(t_data *data)
+{
+	t_stage	*stage;
+	long	next;
+	long	at;
+	int		i;
+
+	next = 0;
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		stage = &data->stages[i++];
+		at = 0;
+		if (stage->status == -1 && !stage->timed_out)
+			at = stage->deadline;
+		else if (stage->status == -1 && stage->timed_out == 1)
+			at = stage->kill_at;
+		if (at && (!next || at < next))
+			next = at;
+	}
+	return (next);
+}
+
+/**
+ * Signals the stages past their deadline.
+ *
+ * A stage past its deadline is sent SIGTERM, and SIGKILL once --kill-after
+ * went by without it exiting. Either way it is reported as timed out.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ */
+void	expire_stages(t_data *data)
+{
+	t_stage	*stage;
+	long	now;
+	int		i;
+
+	now = now_ms();
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		stage = &data->stages[i];
+		if (stage->status == -1 && !stage->timed_out && stage->deadline
+			&& stage->deadline <= now)
+		{
+			signal_stage(data, i, SIGTERM);
+			stage->timed_out = 1;
+			stage->kill_at = now + data->opts.kill_after;
+		}
+		else if (stage->status == -1 && stage->timed_out == 1
+			&& stage->kill_at <= now)
+		{
+			signal_stage(data, i, SIGKILL);
+			stage->timed_out = 2;
+		}
+		i++;
+	}
+}
@@ -6,70 +6,105 @@
 /*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/22 00:39:42 by fde-alen          #+#    #+#             */
-/*   Updated: 2024/01/22 04:44:21 by fde-alen         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:42:00 by fde-alen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "pipex.h"
 
 /**
- * Opens the output file and sets its file descriptor in the data structure.
+ * Checks whether a line of the here_doc body is the LIMITER line.
  *
- * This function determines the correct flags for opening the output file based
- * on whether the 'here_doc' feature is being used. If 'here_doc' is enabled, it
- * opens the file in append mode (O_APPEND), allowing the contents to be added to
- * the end of the file. If 'here_doc' is not enabled, it opens the file in
- * truncate mode (O_TRUNC), which clears the file's existing contents. In both
- * cases, the file is opened for writing (O_WRONLY) and will be created (O_CREAT)
- * if it doesn't already exist, with standard permissions set (0644).
+ * @param[in] line The line, newline included.
+ * @param[in] len Length of the line.
+ * @param[in] limiter The LIMITER.
+ * @return 1 if the line is the LIMITER followed by a newline, 0 otherwise.
+ */
+static int	is_limiter(char *line, ssize_t len, char *limiter)
+{
+	size_t	n;
+
+	n = ft_strlen(limiter);
+	return ((size_t)len == n + 1 && line[n] == '\n'
+		&& !ft_memcmp(line, limiter, n));
+}
+
+/**
+ * Reads the here_doc body from the standard input, up to the LIMITER line.
  *
- * If the file cannot be opened, an error message is printed to standard output
- * using `ft_printf`, displaying the corresponding error from `errno` and the
- * file's name.
+ * A "> " prompt is printed before every line. Lines are read with
+ * `reader_line`, which returns them in place, so reading stays linear in the
+ * size of the body whatever the length of its lines, and are handed to
+ * `heredoc_write`.
  *
- * @param[in,out] data A pointer to the t_data structure containing information
- *                     about the pipeline execution, including the heredoc flag
- *                     and file descriptors for input and output files.
+ * @param[in] data A pointer to the t_data structure containing the LIMITER.
+ * @param[in,out] hd The storage the body is written to.
+ * @return 0 on success, 1 if the body could not be read or stored, with
+ *         errno set, or HEREDOC_EOF if the input ended before the LIMITER
+ *         line.
  */
-static void	handle_heredoc(t_data *data)
+int	heredoc_read(t_data *data, t_heredoc *hd)
 {
-	int		tmp_fd;
-	int		stdin_fd;
-	char	*line;
+	t_reader	reader;
+	char		*line;
+	ssize_t		len;
+	int			err;
 
-	tmp_fd = open(".heredoc.tmp", O_CREAT | O_WRONLY | O_TRUNC, 0644);
-	stdin_fd = dup(STDIN_FILENO);
-	if (tmp_fd == -1)
-		cleanup_n_exit(ft_printf("here_doc: %s\n", strerror(errno)), data);
-	while (1)
+	err = reader_init(&reader, fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, 0));
+	len = 0;
+	while (!err)
 	{
 		ft_putstr_fd("> ", 1);
-		line = get_next_line(stdin_fd);
-		if (line == NULL)
+		len = reader_line(&reader, &line);
+		if (len <= 0 || is_limiter(line, len, data->av[2]))
 			break ;
-		if (ft_strlen(data->av[2]) + 1 == ft_strlen(line)
-			&& !ft_strncmp(line, data->av[2], ft_strlen(data->av[2] + 1)))
-		{
-			close(stdin_fd);
-			break ;
-		}
-		else
-			ft_putstr_fd(line, tmp_fd);
-		free(line);
+		err = heredoc_write(hd, line, len);
 	}
-	close(tmp_fd);
+	reader_free(&reader);
+	if (err || len < 0)
+		return (1);
+	return (HEREDOC_EOF * (len == 0));
+}
+
+/**
+ * Reads the whole here_doc body before the pipeline starts.
+ *
+ * The body is kept in a pipe, a memfd or an anonymous temporary file
+ * depending on its size, see `heredoc_write`, and the descriptor to read it
+ * from becomes the input of the pipeline. If the body cannot be stored, an
+ * error message is printed and the program exits after cleanup. An input
+ * ending before the LIMITER line ends the body, like in a shell.
+ *
+ * @param[in,out] data A pointer to the t_data structure containing the
+ *                     LIMITER and receiving the input file descriptor.
+ */
+static void	handle_heredoc(t_data *data)
+{
+	t_heredoc	hd;
+	int			err;
+
+	err = heredoc_open(&hd, data->opts.heredoc_spill);
+	if (!err)
+		err = heredoc_read(data, &hd);
+	data->input_fd = heredoc_input(&hd);
+	if (err == 1)
+		cleanup_n_exit(ft_printf("pipex: here_doc: %s\n", strerror(errno)),
+			data);
 }
 
 /**
  * Retrieves and opens the input file for the pipex program.
  *
  * This function handles the opening of the input file for the pipex program.
- * If the 'here_doc' flag is set in the t_data structure, it manages the
- * here_doc functionality, creating a temporary file to store the here_doc
- * input. Otherwise, it opens the file specified as the first command line
- * argument. The file descriptor for the opened file is stored in the `input_fd`
- * field of the t_data structure. If the file cannot be opened, an error message
- * is printed, and the program exits after cleanup.
+ * If the 'here_doc' flag is set in the t_data structure, it reads the here_doc
+ * body with `handle_heredoc`, which leaves no file behind, or with
+ * --heredoc-stream hands it to a feeder process, see `heredoc_stream`.
+ * Otherwise, it opens the file specified as the first command line argument.
+ * The file descriptor for the opened file is stored in the `input_fd` field
+ * of the t_data structure. Like every descriptor of pipex it is opened
+ * close-on-exec, stages only inherit their standard input and output. If the
+ * file cannot be opened, an error message is printed, and the program exits
+ * after cleanup.
  *
  * @param[in,out] data Pointer to a t_data structure containing the heredoc flag,
  *                     command line arguments, and the input file descriptor to
@@ -77,19 +112,13 @@ static void	handle_heredoc(t_data *data)
  */
 void	get_input_file(t_data *data)
 {
-	if (data->heredoc_flag == 1)
-	{
+	if (data->heredoc_flag == 1 && data->opts.heredoc_stream)
+		heredoc_stream(data);
+	else if (data->heredoc_flag == 1)
 		handle_heredoc(data);
-		data->input_fd = open(".heredoc.tmp", O_RDONLY);
-		if (data->input_fd == -1)
-		{
-			ft_printf("pipex: here_doc: %s\n", strerror(errno));
-			cleanup_n_exit(ERROR, data);
-		}
-	}
 	else
 	{
-		data->input_fd = open(data->av[1], O_RDONLY, 644);
+		data->input_fd = open(data->av[1], O_RDONLY | O_CLOEXEC);
 		if (data->input_fd == -1)
 		{
 			ft_printf("pipex: %s: %s\n", data->av[1], strerror(errno));
@@ -117,10 +146,10 @@ void	get_output_file(t_data *data)
 {
 	if (data->heredoc_flag == 1)
 		data->output_fd = open(data->av[data->ac - 1],
-				O_WRONLY | O_CREAT | O_APPEND, 0644);
+				O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
 	else
 		data->output_fd = open(data->av[data->ac - 1],
-				O_WRONLY | O_CREAT | O_TRUNC, 0644);
+				O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
 	if (data->output_fd == -1)
 	{
 		cleanup_n_exit(ERROR, data);
@@ -0,0 +1,153 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   heredoc.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 21:52:40 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 21:52:40 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Moves the body written so far to a new descriptor, which receives the rest
+ * of the body.
+ *
+ * @param[in,out] hd The here_doc storage.
+ * @param[in] fd The new descriptor, or -1 if it could not be created.
+ * @return 0 on success, 1 on error.
+ */
+static int	heredoc_move(t_heredoc *hd, int fd)
+{
+	int	err;
+
+	if (fd == -1)
+		return (1);
+	if (hd->rd != -1)
+	{
+		close(hd->fd);
+		hd->fd = hd->rd;
+		hd->rd = -1;
+	}
+	else
+		lseek(hd->fd, 0, SEEK_SET);
+	err = builtin_copy(hd->fd, fd);
+	close(hd->fd);
+	hd->fd = fd;
+	return (err);
+}
+
+/**
+ * Moves the body to the next storage: from the pipe to a memfd, and from the
+ * memfd to an anonymous temporary file in TMPDIR, or /tmp. The file is
+ * created with O_TMPFILE, so it has no name and disappears with its last
+ * descriptor. When no memfd can be created the body goes straight to the
+ * file.
+ *
+ * @param[in,out] hd The here_doc storage.
+ * @return 0 on success, 1 on error.
+ */
+static int	heredoc_grow(t_heredoc *hd)
+{
+	char	*dir;
+	int		fd;
+
+	fd = -1;
+	if (hd->rd != -1)
+		fd = memfd_create("here_doc", MFD_CLOEXEC);
+	hd->cap = hd->spill;
+	if (fd == -1)
+	{
+		dir = getenv("TMPDIR");
+		if (!dir || !*dir)
+			dir = "/tmp";
+		fd = open(dir, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+		hd->cap = SIZE_MAX;
+	}
+	return (heredoc_move(hd, fd));
+}
+
+/**
+ * Prepares the storage of a here_doc body.
+ *
+ * The body starts in a pipe, the first stage then reads it without any copy
+ * once it is complete. Nobody reads the pipe before that, so its write end
+ * is non-blocking and a full pipe is noticed instead of waited on.
+ *
+ * @param[out] hd The here_doc storage.
+ * @param[in] spill Size at which the body moves from a memfd to a temporary
+ *                  file, see --heredoc-spill.
+ * @return 0 on success, 1 on error.
+ */
+int	heredoc_open(t_heredoc *hd, long spill)
+{
+	int	fds[2];
+
+	ft_bzero(hd, sizeof(*hd));
+	hd->fd = -1;
+	hd->rd = -1;
+	hd->spill = spill;
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (1);
+	hd->rd = fds[0];
+	hd->fd = fds[1];
+	return (fcntl(hd->fd, F_SETFL, O_NONBLOCK) == -1);
+}
+
+/**
+ * Appends a line to the here_doc body.
+ *
+ * The body stays in the pipe while it fits in its capacity. Past it the body
+ * moves to a memfd, and past the size of --heredoc-spill to an anonymous
+ * temporary file, see `heredoc_grow`. No file name is ever used, so
+ * concurrent pipelines and read-only directories are not an issue.
+ *
+ * @param[in,out] hd The here_doc storage.
+ * @param[in] line The line.
+ * @param[in] len Length of the line.
+ * @return 0 on success, 1 on error.
+ */
+int	heredoc_write(t_heredoc *hd, char *line, size_t len)
+{
+	ssize_t	n;
+
+	n = 0;
+	if (hd->rd != -1)
+		n = write(hd->fd, line, len);
+	if (n > 0)
+	{
+		hd->size += n;
+		line += n;
+		len -= n;
+	}
+	if (len == 0)
+		return (0);
+	if (n == -1 && errno != EAGAIN)
+		return (1);
+	while (hd->rd != -1 || hd->size + len > hd->cap)
+		if (heredoc_grow(hd))
+			return (1);
+	hd->size += len;
+	return (write_all(hd->fd, line, len));
+}
+
+/**
+ * Ends the here_doc body and returns the descriptor the first stage reads it
+ * from.
+ *
+ * @param[in,out] hd The here_doc storage.
+ * @return The descriptor, positioned at the start of the body.
+ */
+int	heredoc_input(t_heredoc *hd)
+{
+	if (hd->rd == -1)
+	{
+		lseek(hd->fd, 0, SEEK_SET);
+		return (hd->fd);
+	}
+	close(hd->fd);
+	return (hd->rd);
+}
@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   heredoc_stream.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:41:20 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:42:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Reads the here_doc body and writes it to the first stage, in the child
+ * forked by `heredoc_stream`.
+ *
+ * The body goes straight to the pipe, line by line, up to the LIMITER line.
+ * SIGPIPE is ignored, so that a first stage that stops reading early ends
+ * the feeder through EPIPE, which is not an error. Since the pipeline is
+ * already running, an error or an input ending before the LIMITER line is
+ * reported here and through the exit code of the feeder, see
+ * `wait_feeder`.
+ *
+ * @param[in,out] data Pointer to the t_data structure of the child.
+ * @param[in] out Write end of the pipe read by the first stage.
+ */
+static void	feeder_process(t_data *data, int out)
+{
+	t_heredoc	hd;
+	int			err;
+
+	signal(SIGPIPE, SIG_IGN);
+	ft_bzero(&hd, sizeof(hd));
+	hd.fd = out;
+	hd.rd = -1;
+	hd.cap = SIZE_MAX;
+	hd.spill = SIZE_MAX;
+	err = heredoc_read(data, &hd);
+	if (err == 1 && errno == EPIPE)
+		err = 0;
+	else if (err == 1)
+		ft_printf("pipex: here_doc: %s\n", strerror(errno));
+	else if (err == HEREDOC_EOF)
+		ft_printf("pipex: here_doc: end of input before %s\n", data->av[2]);
+	cleanup_n_exit(err != 0, data);
+}
+
+/**
+ * Starts the pipeline on the here_doc body while it is still being read.
+ *
+ * A feeder process is forked that reads the body and writes it to a pipe,
+ * whose read end becomes the input of the first stage. The stages are then
+ * launched right away, so the time to the first output no longer depends on
+ * the size of the body, and the body is never stored.
+ *
+ * @param[in,out] data Pointer to the t_data structure receiving the input
+ *                     file descriptor.
+ */
+void	heredoc_stream(t_data *data)
+{
+	int	fds[2];
+
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		cleanup_n_exit(ft_printf("pipex: Could not create pipe: %s\n",
+				strerror(errno)), data);
+	data->feeder_pid = fork();
+	if (data->feeder_pid == -1)
+		cleanup_n_exit(ft_printf("fork error: %s\n", strerror(errno)), data);
+	if (data->feeder_pid == 0)
+	{
+		close(fds[0]);
+		feeder_process(data, fds[1]);
+	}
+	close(fds[1]);
+	data->input_fd = fds[0];
+}
+
+/**
+ * Waits for the feeder process of --heredoc-stream, and records its failure
+ * with `record_helper`, so that pipex fails like it does when the body
+ * cannot be read without the option.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding its process
+ *                     ID.
+ */
+void	wait_feeder(t_data *data)
+{
+	int	status;
+
+	if (data->feeder_pid > 0 && waitpid(data->feeder_pid, &status, 0) > 0)
+		record_helper(data, status);
+	data->feeder_pid = 0;
+}
@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   jit_pipes.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 12:20:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 17:32:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Creates the pipe the current stage writes to, with --jit-pipes.
+ *
+ * Without the option every pipe is created up front by `setup_pipes`, and the
+ * parent holds 2 * (n - 1) descriptors while the stages start, which runs
+ * into RLIMIT_NOFILE for pipelines of a few thousand stages and makes every
+ * fork copy a descriptor table that grows with the pipeline. With it, the
+ * pipe of a stage is only created right before that stage is launched. The
+ * last stage writes to the output file and gets no pipe.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the current
+ *                     child index and the pipes of the current stage.
+ */
+void	open_next_pipe(t_data *data)
+{
+	if (!data->opts.jit_pipes || data->child >= data->cmd_count - 1)
+		return ;
+	if (pipe2(data->next_pipe, O_CLOEXEC) == -1)
+	{
+		ft_printf("pipex: Could not create pipe: %s\n", strerror(errno));
+		cleanup_n_exit(ERROR, data);
+	}
+	meter_edge(data, data->child + 1, data->next_pipe);
+	tee_edge(data, data->child + 1, data->next_pipe);
+	apply_pipe_size(data, data->child + 1, data->next_pipe);
+}
+
+/**
+ * Closes the copies the parent holds of the pipes of a launched stage, with
+ * --jit-pipes.
+ *
+ * The read end of the previous pipe now belongs to the launched stage alone,
+ * and the write end of the new pipe to it as well. Only the read end of the
+ * new pipe is kept, for the next stage. The parent thus holds at most three
+ * pipe ends at any time, whatever the number of stages.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the pipes of the
+ *                     current stage.
+ */
+void	close_prev_pipe(t_data *data)
+{
+	if (!data->opts.jit_pipes)
+		return ;
+	if (data->prev_read != -1)
+		close(data->prev_read);
+	if (data->next_pipe[1] != -1)
+		close(data->next_pipe[1]);
+	data->prev_read = data->next_pipe[0];
+	data->next_pipe[0] = -1;
+	data->next_pipe[1] = -1;
+}
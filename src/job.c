@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   job.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:31:02 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Resolves the commands of a pipeline ahead of time in a template data.
+ *
+ * The commands are remembered in the template, see `memo_store`, so that
+ * the pipelines later started from it with `job_run` find them without a
+ * PATH lookup. Commands run in-process are skipped, as `plan_stages` does.
+ *
+ * @param[in,out] tmpl The template data.
+ * @param[in] ac Count of arguments of the pipeline.
+ * @param[in] av Argument vector of the pipeline: "pipex", infile, commands,
+ *               outfile.
+ */
+void	job_resolve(t_data *tmpl, int ac, char **av)
+{
+	char	**argv;
+	int		i;
+
+	i = 2;
+	while (i < ac - 1)
+	{
+		argv = ft_split(av[i++], ' ');
+		if (argv && argv[0] && !(tmpl->opts.builtins && find_builtin(argv)))
+			free(resolve_cmd(argv[0], tmpl));
+		free_array(argv);
+	}
+}
+
+/**
+ * Runs a pipeline like `main` would, starting from a template data.
+ *
+ * The pipeline uses the PATH directories, their index once built and the
+ * commands resolved in the template instead of looking them up again, and
+ * the helpers forked in the template with --zygotes, see `start_zygotes`.
+ * Meant for a process forked for the pipeline, which owns its copy of the
+ * template.
+ *
+ * @param[in] tmpl The template data.
+ * @param[in] ac Count of arguments of the pipeline.
+ * @param[in] av Argument vector of the pipeline: "pipex", infile, commands,
+ *               outfile.
+ * @return The exit code of the pipeline.
+ */
+int	job_run(t_data *tmpl, int ac, char **av)
+{
+	t_data	data;
+
+	data = init_data(ac, av, tmpl->envp, &tmpl->opts);
+	data.paths = tmpl->paths;
+	if (tmpl->index.size)
+		data.index = tmpl->index;
+	data.memo = tmpl->memo;
+	data.zygotes = tmpl->zygotes;
+	data.zygote_count = tmpl->zygote_count;
+	return (pipex(&data));
+}
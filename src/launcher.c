@@ -0,0 +1,180 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   launcher.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:26:48 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:53:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Selects the standard input and output of the current stage.
+ *
+ * The first stage reads from the input file and every other stage reads from
+ * the read-end of the pipe written by the previous stage. The last stage
+ * writes to the output file and every other stage writes to the write-end of
+ * its own pipe. With --jit-pipes these are the two pipes held by
+ * `open_next_pipe` instead of entries of the pipe array.
+ *
+ * @param[in] data Pointer to a t_data structure holding the current child
+ *                 index, the pipe array and the input and output files.
+ * @param[out] in File descriptor the stage reads from.
+ * @param[out] out File descriptor the stage writes to.
+ */
+void	stage_io(t_data *data, int *in, int *out)
+{
+	*in = data->input_fd;
+	*out = data->output_fd;
+	if (data->child > 0 && data->opts.jit_pipes)
+		*in = data->prev_read;
+	else if (data->child > 0)
+		*in = data->pipe[2 * data->child - 2];
+	if (data->child < data->cmd_count - 1 && data->opts.jit_pipes)
+		*out = data->next_pipe[1];
+	else if (data->child < data->cmd_count - 1)
+		*out = data->pipe[2 * data->child + 1];
+}
+
+/**
+ * Starts the current stage with `posix_spawn`.
+ *
+ * The redirections done by `redirect_io` in a forked child are expressed as
+ * file actions, so the stage is started without duplicating the address
+ * space of pipex. The stage gets a process group of its own, as a forked
+ * stage does, see `launch_stage`. The other descriptors of pipex are
+ * close-on-exec and need no action. The C library implements this with a
+ * vfork style clone, which keeps the launch cost independent of the size of
+ * the parent.
+ *
+ * @param[in] data Pointer to a t_data structure holding the command to run.
+ * @param[in] in File descriptor to use as the standard input of the command.
+ * @param[in] out File descriptor to use as the standard output of the command.
+ * @return The process ID of the stage, or -1 if it could not be spawned.
+ */
+static pid_t	spawn_stage(t_data *data, int in, int out)
+{
+	posix_spawn_file_actions_t	fa;
+	posix_spawnattr_t			attr;
+	pid_t						pid;
+	int							err;
+
+	if (posix_spawnattr_init(&attr) != 0)
+		return (-1);
+	err = posix_spawn_file_actions_init(&fa);
+	if (!err)
+		err = posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+	if (!err)
+		err = posix_spawn_file_actions_adddup2(&fa, in, STDIN_FILENO);
+	if (!err)
+		err = posix_spawn_file_actions_adddup2(&fa, out, STDOUT_FILENO);
+	if (!err)
+		err = posix_spawn(&pid, data->stages[data->child].path, &fa, &attr,
+				data->stages[data->child].argv, data->envp);
+	posix_spawn_file_actions_destroy(&fa);
+	posix_spawnattr_destroy(&attr);
+	if (err)
+		return (-1);
+	return (pid);
+}
+
+/**
+ * Starts the current stage without forking pipex, when it can.
+ *
+ * Stages whose command was found, that are not pinned to CPUs, that keep the
+ * priorities of pipex and whose descriptors are valid are handed to a helper
+ * forked with --zygotes, see `zygote_exec`, or else started with
+ * `spawn_stage` with the spawn launcher.
+ *
+ * @param[in,out] data Pointer to a t_data structure describing the stage.
+ * @param[in] in File descriptor to use as the standard input of the command.
+ * @param[in] out File descriptor to use as the standard output of the command.
+ * @return The process ID of the stage, or -1 if it must be forked.
+ */
+static pid_t	start_exec(t_data *data, int in, int out)
+{
+	t_stage	*stage;
+	pid_t	pid;
+
+	stage = &data->stages[data->child];
+	if (!stage->path || stage->workers || stage->pinned
+		|| stage->tuned || in < 0 || out < 0)
+		return (-1);
+	pid = zygote_exec(data, in, out);
+	if (pid <= 0 && data->opts.launcher == LAUNCH_SPAWN)
+		pid = spawn_stage(data, in, out);
+	return (pid);
+}
+
+/**
+ * Starts the current stage of the pipeline.
+ *
+ * Stages are first started without forking pipex by `start_exec` when they
+ * can. Every other stage, and every stage with the fork launcher and no
+ * helper left, is started by forking a child that runs
+ * `execute_child_process`, so error handling stays the same in all modes. A
+ * failed spawn falls back to the fork path as well. A stage run
+ * with --parallel is always forked, its process dispatches the input to the
+ * workers. Every stage runs in a process group of its own, set on both sides
+ * of the fork so that it exists before either goes on, which lets a deadline
+ * reach the processes the stage started too, see `signal_stage`. The O_PATH
+ * descriptor of the binary, opened by `plan_stage`, is closed in the parent
+ * once the stage is started.
+ *
+ * @param[in,out] data Pointer to a t_data structure describing the stage.
+ * @return The process ID of the started stage.
+ */
+static pid_t	launch_stage(t_data *data)
+{
+	t_stage	*stage;
+	pid_t	pid;
+	int		in;
+	int		out;
+
+	stage = &data->stages[data->child];
+	stage_io(data, &in, &out);
+	pid = start_exec(data, in, out);
+	if (pid <= 0)
+	{
+		pid = fork();
+		if (pid > 0)
+			setpgid(pid, pid);
+	}
+	if (pid == -1)
+		cleanup_n_exit(ft_printf("fork error: %s\n", strerror(errno)), data);
+	else if (pid == 0)
+		execute_child_process(data, in, out);
+	if (stage->exec_fd != -1)
+		close(stage->exec_fd);
+	stage->exec_fd = -1;
+	return (pid);
+}
+
+/**
+ * Starts every stage of the pipeline back to back.
+ *
+ * Each stage gets its pipe with --jit-pipes and its deadline with --timeout
+ * or --stage-timeout right as it starts. The start time used by --stats is
+ * taken before the stage is launched, so its wall time includes the launch.
+ *
+ * @param[in,out] data Pointer to a t_data structure describing the stages,
+ *                     receiving their process IDs.
+ */
+void	launch_stages(t_data *data)
+{
+	data->start = now_ms();
+	data->child = 0;
+	while (data->child < data->cmd_count)
+	{
+		open_next_pipe(data);
+		data->stages[data->child].started = now_us();
+		data->pids[data->child] = launch_stage(data);
+		set_deadline(data, data->child);
+		close_prev_pipe(data);
+		data->child++;
+	}
+}
@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   line_reader.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 17:58:40 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 17:58:40 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Prepares a reader on a descriptor.
+ *
+ * @param[out] reader The reader.
+ * @param[in] fd Descriptor to read from, or -1 for an empty input.
+ * @return 0 on success, 1 if memory runs out.
+ */
+int	reader_init(t_reader *reader, int fd)
+{
+	ft_bzero(reader, sizeof(*reader));
+	reader->fd = fd;
+	reader->eof = (fd < 0);
+	reader->size = BUILTIN_BUF_SIZE;
+	reader->buf = malloc(reader->size);
+	return (reader->buf == NULL);
+}
+
+/**
+ * Reads more input into the buffer of a reader.
+ *
+ * The bytes not returned yet are first moved to the start of the buffer, and
+ * the buffer is doubled when they fill it, so that a line of any length fits.
+ * Every byte is moved at most once per refill, which keeps reading linear in
+ * the size of the input.
+ *
+ * @param[in,out] reader The reader.
+ * @return 0 on success, 1 on error.
+ */
+static int	reader_fill(t_reader *reader)
+{
+	char	*buf;
+	ssize_t	n;
+
+	if (reader->start > 0)
+		ft_memmove(reader->buf, reader->buf + reader->start, reader->len);
+	reader->start = 0;
+	if (reader->len == reader->size)
+	{
+		buf = malloc(reader->size * 2);
+		if (!buf)
+			return (1);
+		ft_memcpy(buf, reader->buf, reader->len);
+		free(reader->buf);
+		reader->buf = buf;
+		reader->size *= 2;
+	}
+	n = read(reader->fd, reader->buf + reader->len, reader->size - reader->len);
+	while (n == -1 && errno == EINTR)
+		n = read(reader->fd, reader->buf + reader->len,
+				reader->size - reader->len);
+	if (n == 0)
+		reader->eof = 1;
+	if (n > 0)
+		reader->len += n;
+	return (n < 0);
+}
+
+/**
+ * Returns the next line of the input, newline included.
+ *
+ * The line points into the buffer of the reader and stays valid until the
+ * next call. The bytes already searched for a newline are not searched
+ * again after a refill. The last line of an input that does not end with a
+ * newline is returned without one.
+ *
+ * @param[in,out] reader The reader.
+ * @param[out] line The line.
+ * @return The length of the line, 0 at end of input, -1 on error.
+ */
+ssize_t	reader_line(t_reader *reader, char **line)
+{
+	char	*nl;
+	size_t	scan;
+	size_t	n;
+
+	scan = 0;
+	while (1)
+	{
+		nl = ft_memchr(reader->buf + reader->start + scan, '\n',
+				reader->len - scan);
+		if (nl || (reader->eof && reader->len > 0))
+		{
+			n = reader->len;
+			if (nl)
+				n = nl - (reader->buf + reader->start) + 1;
+			*line = reader->buf + reader->start;
+			reader->start += n;
+			reader->len -= n;
+			return (n);
+		}
+		if (reader->eof)
+			return (0);
+		scan = reader->len;
+		if (reader_fill(reader))
+			return (-1);
+	}
+}
+
+/**
+ * Frees the buffer of a reader and closes its descriptor.
+ *
+ * @param[in,out] reader The reader.
+ */
+void	reader_free(t_reader *reader)
+{
+	free(reader->buf);
+	reader->buf = NULL;
+	if (reader->fd >= 0)
+		close(reader->fd);
+	reader->fd = -1;
+}
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   memo.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:02:11 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 19:02:11 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Looks a command up in the commands resolved so far.
+ *
+ * @param[in] data Pointer to the t_data structure holding the resolved
+ *                 commands.
+ * @param[in] cmd Name of the command.
+ * @param[out] path A copy of its full path, or NULL if it was not found.
+ * @return 1 if the command was resolved before, 0 otherwise.
+ */
+int	memo_lookup(t_data *data, char *cmd, char **path)
+{
+	t_list	*node;
+	t_memo	*memo;
+
+	*path = NULL;
+	node = data->memo;
+	while (node)
+	{
+		memo = node->content;
+		if (!ft_strncmp(memo->cmd, cmd, ft_strlen(cmd) + 1))
+		{
+			if (memo->path)
+				*path = ft_strdup(memo->path);
+			return (1);
+		}
+		node = node->next;
+	}
+	return (0);
+}
+
+/**
+ * Frees one resolved command.
+ *
+ * @param[in] content The t_memo to free.
+ */
+static void	free_memo(void *content)
+{
+	t_memo	*memo;
+
+	memo = content;
+	free(memo->cmd);
+	free(memo->path);
+	free(memo);
+}
+
+/**
+ * Remembers the path a command was resolved to.
+ *
+ * Nothing is remembered if memory runs out, the command is then resolved
+ * again the next time.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the resolved
+ *                     commands.
+ * @param[in] cmd Name of the command.
+ * @param[in] path Its full path, or NULL if it was not found. Copied.
+ */
+void	memo_store(t_data *data, char *cmd, char *path)
+{
+	t_memo	*memo;
+	t_list	*node;
+
+	memo = ft_calloc(1, sizeof(*memo));
+	if (!memo)
+		return ;
+	memo->cmd = ft_strdup(cmd);
+	if (path)
+		memo->path = ft_strdup(path);
+	node = NULL;
+	if (memo->cmd && (!path || memo->path))
+		node = ft_lstnew(memo);
+	if (!node)
+	{
+		free_memo(memo);
+		return ;
+	}
+	ft_lstadd_front(&data->memo, node);
+}
+
+/**
+ * Frees the commands resolved so far.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding them.
+ */
+void	memo_free(t_data *data)
+{
+	ft_lstclear(&data->memo, free_memo);
+}
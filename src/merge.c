@@ -0,0 +1,164 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   merge.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 18:29:55 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:57:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Merges the inputs with the policy chosen with --merge.
+ *
+ * Every input gets a line reader. For a sorted merge the first line of each
+ * input is read up front, the other policies start with every input marked
+ * as not exhausted.
+ *
+ * @param[in] data Pointer to the t_data structure holding the options.
+ * An input added with --input that could not be opened is merged as an
+ * empty one, but still makes the merge fail.
+ *
+ * @param[in,out] src The inputs, with their descriptors set.
+ * @param[in] count Number of inputs.
+ * @return 0 on success, 1 on error.
+ */
+static int	run_merge(t_data *data, t_source *src, int count)
+{
+	int	missing;
+	int	err;
+	int	i;
+
+	missing = 0;
+	err = 0;
+	i = 0;
+	while (i < count)
+	{
+		missing |= (i > 0 && src[i].reader.fd < 0);
+		err |= reader_init(&src[i].reader, src[i].reader.fd);
+		src[i].len = 1;
+		if (!err && data->opts.merge == MERGE_SORTED)
+			src[i].len = reader_line(&src[i].reader, &src[i].line);
+		err |= (src[i++].len < 0);
+	}
+	if (!err && data->opts.merge == MERGE_SORTED)
+		err = merge_sorted(src, count);
+	else if (!err && data->opts.merge == MERGE_INTERLEAVE)
+		err = merge_interleave(src, count);
+	else if (!err)
+		err = merge_concat(src, count);
+	while (i > 0)
+		reader_free(&src[--i].reader);
+	return (err | missing);
+}
+
+/**
+ * Waits for the pipelines of the inputs, in the merge process.
+ *
+ * @return 1 if one of them did not exit with 0, 0 otherwise.
+ */
+static int	wait_inputs(void)
+{
+	int	status;
+	int	err;
+
+	err = 0;
+	while (wait(&status) > 0)
+		err |= (!WIFEXITED(status) || WEXITSTATUS(status) != 0);
+	return (err);
+}
+
+/**
+ * Runs the merge of the inputs, in the child forked by `setup_merge`.
+ *
+ * The infile becomes the standard input and the pipe to the first stage the
+ * standard output, and every other descriptor inherited from pipex is
+ * closed, `input_fd` then referring to the standard input. The inputs are
+ * then opened and merged, and the pipelines of the inputs waited for. The
+ * merge exits with 1 if it failed or one of the inputs did, see
+ * `wait_inputs`. SIGPIPE is ignored, so that a first stage that stops
+ * reading early ends the merge through EPIPE, which is not a failure, like
+ * a writer killed by SIGPIPE in a shell pipeline.
+ *
+ * @param[in,out] data Pointer to the t_data structure of the child.
+ * @param[in] out Write end of the pipe read by the first stage.
+ */
+static void	merge_process(t_data *data, int out)
+{
+	t_source	*src;
+	int			count;
+	int			err;
+	int			gone;
+	int			fd;
+
+	signal(SIGPIPE, SIG_IGN);
+	if (dup2(out, STDOUT_FILENO) == -1 || (data->input_fd >= 0
+			&& dup2(data->input_fd, STDIN_FILENO) == -1))
+		cleanup_n_exit(ERROR, data);
+	if (data->input_fd < 0)
+		close(STDIN_FILENO);
+	fd = data->input_fd;
+	close_inherited(data);
+	if (fd >= 0)
+		data->input_fd = STDIN_FILENO;
+	src = open_sources(data, &count);
+	err = (src == NULL);
+	if (src)
+		err = run_merge(data, src, count);
+	gone = (err && errno == EPIPE);
+	free(src);
+	err |= wait_inputs();
+	cleanup_n_exit(err && !gone, data);
+}
+
+/**
+ * Replaces the infile with the merge of the infile and the inputs added with
+ * --input.
+ *
+ * A merge process is forked that reads every input and writes the merged
+ * stream to a pipe, whose read end becomes the input of the first stage in
+ * place of the infile opened by `get_input_file`. The inputs are read
+ * straight from their files or pipelines, without going through temporary
+ * files. Without --input the infile is used as is.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the infile.
+ */
+void	setup_merge(t_data *data)
+{
+	int	fds[2];
+
+	if (!data->opts.inputs)
+		return ;
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		cleanup_n_exit(ft_printf("pipex: Could not create pipe: %s\n",
+				strerror(errno)), data);
+	data->merge_pid = fork();
+	if (data->merge_pid == -1)
+		cleanup_n_exit(ft_printf("fork error: %s\n", strerror(errno)), data);
+	if (data->merge_pid == 0)
+		merge_process(data, fds[1]);
+	close(fds[1]);
+	if (data->input_fd >= 0)
+		close(data->input_fd);
+	data->input_fd = fds[0];
+}
+
+/**
+ * Waits for the merge process of --input, and records its failure with
+ * `record_helper`.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding its process
+ *                     ID.
+ */
+void	wait_merge(t_data *data)
+{
+	int	status;
+
+	if (data->merge_pid > 0 && waitpid(data->merge_pid, &status, 0) > 0)
+		record_helper(data, status);
+	data->merge_pid = 0;
+}
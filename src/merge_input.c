@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   merge_input.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 18:21:37 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 18:21:37 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Opens an input added with --input, in the merge process.
+ *
+ * A plain file is opened for reading. An input with commands is run through
+ * a pipeline of its own, see `exec_subpipeline`, writing to a pipe the merge
+ * reads. Every input is opened before the merge starts, so the pipelines of
+ * the inputs run side by side.
+ *
+ * @param[in] data Pointer to the t_data structure of the merge process.
+ * @param[in] input The input.
+ * @return A descriptor to read the input from, or -1 if it could not be
+ *         opened, in which case it is merged as an empty input.
+ */
+static int	open_input(t_data *data, t_input *input)
+{
+	int		fds[2];
+	pid_t	pid;
+
+	if (!input->cmds)
+	{
+		fds[0] = open(input->file, O_RDONLY | O_CLOEXEC);
+		if (fds[0] == -1)
+			ft_printf("pipex: %s: %s\n", input->file, strerror(errno));
+		return (fds[0]);
+	}
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (-1);
+	pid = fork();
+	if (pid == 0)
+	{
+		if (dup2(fds[1], STDOUT_FILENO) == -1)
+			cleanup_n_exit(ERROR, data);
+		exec_subpipeline(data, input->file, input->cmds, "/dev/stdout");
+	}
+	close(fds[1]);
+	if (pid != -1)
+		return (fds[0]);
+	close(fds[0]);
+	return (-1);
+}
+
+/**
+ * Opens every input of the merge, the infile first, then the inputs added
+ * with --input in the order they were given.
+ *
+ * @param[in] data Pointer to the t_data structure of the merge process,
+ *                 whose standard input is the infile, or closed if the
+ *                 infile could not be opened.
+ * @param[out] count Number of inputs.
+ * @return The inputs, with their descriptors set, or NULL if memory runs
+ *         out.
+ */
+t_source	*open_sources(t_data *data, int *count)
+{
+	t_source	*src;
+	t_list		*node;
+	int			i;
+
+	*count = ft_lstsize(data->opts.inputs) + 1;
+	src = ft_calloc(*count, sizeof(*src));
+	if (!src)
+		return (NULL);
+	src[0].reader.fd = STDIN_FILENO;
+	if (data->input_fd < 0)
+		src[0].reader.fd = -1;
+	node = data->opts.inputs;
+	i = 1;
+	while (node)
+	{
+		src[i++].reader.fd = open_input(data, node->content);
+		node = node->next;
+	}
+	return (src);
+}
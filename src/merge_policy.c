@@ -0,0 +1,173 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   merge_policy.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 18:06:12 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 18:06:12 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Appends a line to the output of the merge, writing the output out once
+ * BUILTIN_BUF_SIZE bytes are pending.
+ *
+ * A last line without a newline gets one, so that it does not run into the
+ * line of the next input.
+ *
+ * @param[in,out] out The pending output.
+ * @param[in] line The line.
+ * @param[in] len Length of the line.
+ * @return 0 on success, 1 on error.
+ */
+static int	emit(t_strbuf *out, char *line, ssize_t len)
+{
+	int	err;
+
+	sb_add_len(out, line, len);
+	if (line[len - 1] != '\n')
+		sb_add_len(out, "\n", 1);
+	if (out->error || out->len < BUILTIN_BUF_SIZE)
+		return (out->error);
+	err = write_all(STDOUT_FILENO, out->str, out->len);
+	out->len = 0;
+	return (err);
+}
+
+/**
+ * Compares the pending lines of two inputs byte-wise, newlines excluded, a
+ * line sorting before the lines it is a prefix of.
+ *
+ * @param[in] a The first input.
+ * @param[in] b The second input.
+ * @return A negative value if the line of `a` sorts first, a positive value
+ *         if the line of `b` does, 0 if they are equal.
+ */
+static int	line_cmp(t_source *a, t_source *b)
+{
+	size_t	la;
+	size_t	lb;
+	int		cmp;
+
+	la = a->len - (a->line[a->len - 1] == '\n');
+	lb = b->len - (b->line[b->len - 1] == '\n');
+	if (la < lb)
+		cmp = ft_memcmp(a->line, b->line, la);
+	else
+		cmp = ft_memcmp(a->line, b->line, lb);
+	if (cmp)
+		return (cmp);
+	return ((la > lb) - (la < lb));
+}
+
+/**
+ * Copies the inputs to the standard output one after the other.
+ *
+ * Nothing is split into lines, each input is moved with `builtin_copy`,
+ * which splices pipes without copying them through user space.
+ *
+ * @param[in,out] src The inputs, -1 descriptors being skipped.
+ * @param[in] count Number of inputs.
+ * @return 0 on success, 1 on error.
+ */
+int	merge_concat(t_source *src, int count)
+{
+	int	err;
+	int	i;
+
+	err = 0;
+	i = 0;
+	while (i < count)
+	{
+		if (src[i].reader.fd >= 0)
+			err |= builtin_copy(src[i].reader.fd, STDOUT_FILENO);
+		i++;
+	}
+	return (err);
+}
+
+/**
+ * Writes one line of each input in turn, skipping the exhausted ones, until
+ * all of them are exhausted.
+ *
+ * An input whose `len` is 0 is exhausted, every input starts with a positive
+ * one.
+ *
+ * @param[in,out] src The inputs.
+ * @param[in] count Number of inputs.
+ * @return 0 on success, 1 on error.
+ */
+int	merge_interleave(t_source *src, int count)
+{
+	t_strbuf	out;
+	int			left;
+	int			err;
+	int			i;
+
+	ft_bzero(&out, sizeof(out));
+	err = 0;
+	left = count;
+	while (left > 0 && !err)
+	{
+		left = 0;
+		i = 0;
+		while (i < count)
+		{
+			if (src[i].len > 0)
+				src[i].len = reader_line(&src[i].reader, &src[i].line);
+			if (src[i].len > 0)
+			{
+				err |= emit(&out, src[i].line, src[i].len);
+				left++;
+			}
+			err |= (src[i++].len < 0);
+		}
+	}
+	return (sb_flush(&out, STDOUT_FILENO) | err);
+}
+
+/**
+ * Merges inputs that are each sorted byte-wise into one sorted output.
+ *
+ * The pending lines of all inputs are compared and the smallest is written,
+ * then replaced by the next line of its input. Every input starts with its
+ * first line pending, see `run_merge`. Equal lines are written in
+ * the order of the inputs, so the merge is stable. The number of inputs is
+ * small, so a linear scan finds the smallest line faster than a heap would.
+ *
+ * @param[in,out] src The inputs.
+ * @param[in] count Number of inputs.
+ * @return 0 on success, 1 on error.
+ */
+int	merge_sorted(t_source *src, int count)
+{
+	t_strbuf	out;
+	int			err;
+	int			min;
+	int			i;
+
+	ft_bzero(&out, sizeof(out));
+	err = 0;
+	min = 0;
+	while (min >= 0 && !err)
+	{
+		min = -1;
+		i = 0;
+		while (i < count)
+		{
+			if (src[i].len > 0 && (min < 0 || line_cmp(&src[i], &src[min]) < 0))
+				min = i;
+			i++;
+		}
+		if (min >= 0)
+			err = emit(&out, src[min].line, src[min].len);
+		if (min >= 0)
+			src[min].len = reader_line(&src[min].reader, &src[min].line);
+		err |= (min >= 0 && src[min].len < 0);
+	}
+	return (sb_flush(&out, STDOUT_FILENO) | err);
+}
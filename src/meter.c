@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   meter.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 15:05:40 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 15:05:40 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Maps the shared array the --meter relays report their traffic in.
+ *
+ * The array holds one t_meter per pipe and is mapped shared and anonymous,
+ * so every relay forked afterwards writes to the same pages the parent reads.
+ * Without --meter nothing is mapped and `meter_edge` returns right away, so
+ * the pipes are exactly those of a pipeline without the option.
+ *
+ * @param[in,out] data Pointer to the t_data structure with the final command
+ *                     count, receiving the array.
+ */
+void	setup_meters(t_data *data)
+{
+	void	*map;
+
+	if (!data->opts.meter || data->cmd_count < 2)
+		return ;
+	map = mmap(NULL, sizeof(t_meter) * (data->cmd_count - 1),
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED)
+	{
+		ft_printf("pipex: Meter error: %s\n", strerror(errno));
+		cleanup_n_exit(ERROR, data);
+	}
+	data->meters = map;
+}
+
+/**
+ * Tells whether a pipe was selected with --meter.
+ *
+ * @param[in] data Pointer to the t_data structure holding the options.
+ * @param[in] edge Number of the pipe, counting from 1.
+ * @return Non-zero if the pipe is metered.
+ */
+static int	is_metered(t_data *data, int edge)
+{
+	t_list	*node;
+
+	if (!data->opts.meter_edges)
+		return (1);
+	node = data->opts.meter_edges;
+	while (node)
+	{
+		if (*(int *)node->content == edge)
+			return (1);
+		node = node->next;
+	}
+	return (0);
+}
+
+/**
+ * Inserts a relay process in a new pipe selected with --meter.
+ *
+ * A second pipe is created and a child is forked that moves everything from
+ * the read end of the first pipe to the write end of the second, see
+ * `relay_process`. The writing stage keeps the write end of the first pipe and
+ * the reading stage gets the read end of the second one in its place, so the
+ * stages are launched exactly as without the relay. The relay only holds its
+ * two ends, on its standard input and output, so end of file and broken
+ * pipes still travel through it. Only the parent stores the process ID in
+ * the shared entry.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the meters.
+ * @param[in] edge Number of the pipe, counting from 1.
+ * @param[in,out] fds The two descriptors of the pipe, the read end being
+ *                    replaced by the read end of the second pipe.
+ */
+void	meter_edge(t_data *data, int edge, int *fds)
+{
+	t_meter	*meter;
+	pid_t	pid;
+	int		out[2];
+
+	if (!data->meters || !is_metered(data, edge))
+		return ;
+	meter = &data->meters[edge - 1];
+	if (pipe2(out, O_CLOEXEC) == -1)
+		cleanup_n_exit(ft_printf("pipex: Could not create pipe: %s\n",
+				strerror(errno)), data);
+	apply_pipe_size(data, edge, out);
+	pid = fork();
+	if (pid == -1)
+		cleanup_n_exit(ft_printf("fork error: %s\n", strerror(errno)), data);
+	if (pid == 0)
+		relay_process(data, meter, fds[0], out[1]);
+	meter->pid = pid;
+	close(fds[0]);
+	close(out[1]);
+	fds[0] = out[0];
+}
+
+/**
+ * Waits for every --meter relay, so that their counters are final.
+ *
+ * A relay exits once the writing stage closed its end of the pipe or the
+ * reading stage closed its own, so the relays are done shortly after the
+ * stages. A relay already reaped by `reap_ready` is not waited for again.
+ *
+ * @param[in] data Pointer to the t_data structure holding the meters.
+ */
+void	wait_meters(t_data *data)
+{
+	int	i;
+
+	if (!data->meters)
+		return ;
+	i = 0;
+	while (i < data->cmd_count - 1)
+	{
+		if (data->meters[i].pid > 0)
+			waitpid(data->meters[i].pid, NULL, 0);
+		i++;
+	}
+}
+
+/**
+ * Unmaps the shared array of --meter.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the meters.
+ */
+void	free_meters(t_data *data)
+{
+	if (!data->meters)
+		return ;
+	munmap(data->meters, sizeof(t_meter) * (data->cmd_count - 1));
+	data->meters = NULL;
+}
@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   meter_relay.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 15:11:02 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 15:11:02 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Waits until the relay can move data, and accounts for the time waited.
+ *
+ * Waiting for POLLIN on the standard input is time spent waiting for the
+ * writing stage, waiting for POLLOUT on the standard output is time spent
+ * waiting for the reading stage to drain its pipe. While waiting for input,
+ * the standard output is watched too, so that the relay notices right away
+ * when the reading stage is gone.
+ *
+ * @param[in,out] meter The entry of the relay.
+ * @param[in] events POLLIN to wait for input, POLLOUT to wait for room.
+ * @return Non-zero if the relay may go on, 0 if the reading stage is gone.
+ */
+static int	wait_fd(t_meter *meter, short events)
+{
+	struct pollfd	fds[2];
+	long			start;
+	int				n;
+
+	fds[0].fd = STDIN_FILENO;
+	if (events == POLLOUT)
+		fds[0].fd = -1;
+	fds[0].events = POLLIN;
+	fds[1].fd = STDOUT_FILENO;
+	fds[1].events = events & POLLOUT;
+	start = now_us();
+	n = poll(fds, 2, -1);
+	while (n == -1 && errno == EINTR)
+		n = poll(fds, 2, -1);
+	if (events == POLLIN)
+		meter->read_wait += now_us() - start;
+	else
+		meter->write_wait += now_us() - start;
+	return (n > 0 && !(fds[1].revents & POLLERR));
+}
+
+/**
+ * Moves one batch of data from the standard input to the standard output.
+ *
+ * Both are pipes, so `splice` moves the pages from one pipe to the other
+ * without copying them through user space. It is called non-blocking, so
+ * that a full output pipe is waited for with `wait_fd` and counted as
+ * backpressure.
+ *
+ * @param[in,out] meter The entry of the relay.
+ * @return The number of bytes moved, 0 at end of file, -1 on error.
+ */
+static ssize_t	relay_chunk(t_meter *meter)
+{
+	ssize_t	n;
+
+	n = splice(STDIN_FILENO, NULL, STDOUT_FILENO, NULL, METER_CHUNK,
+			SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	while (n == -1 && errno == EAGAIN && wait_fd(meter, POLLOUT))
+		n = splice(STDIN_FILENO, NULL, STDOUT_FILENO, NULL, METER_CHUNK,
+				SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	if (n > 0)
+	{
+		meter->bytes += n;
+		meter->splices++;
+	}
+	return (n);
+}
+
+/**
+ * Moves data through the relay of a pipe metered with --meter.
+ *
+ * Data is moved until the writing stage closes its end, or until the reading
+ * stage closes its own, in which case the relay stops as well and the writing
+ * stage gets SIGPIPE on its next write, like without the relay.
+ *
+ * @param[in,out] meter The entry of the relay, in the shared array.
+ */
+static void	run_relay(t_meter *meter)
+{
+	ssize_t	n;
+
+	meter->started = now_us();
+	n = 1;
+	while (n > 0 && wait_fd(meter, POLLIN))
+		n = relay_chunk(meter);
+	meter->ended = now_us();
+}
+
+/**
+ * Runs the relay of a pipe metered with --meter, in the child forked by
+ * `meter_edge`.
+ *
+ * The two pipe ends of the relay become its standard input and output and
+ * every other descriptor inherited from pipex is closed, so that the relay
+ * does not keep any other pipe of the pipeline open. SIGPIPE is ignored, so
+ * that a reading stage that is gone ends the relay through EPIPE and the
+ * counters are still complete.
+ *
+ * @param[in,out] data Pointer to the t_data structure of the child.
+ * @param[in,out] meter The entry of the relay, in the shared array.
+ * @param[in] in Read end of the pipe written by the writing stage.
+ * @param[in] out Write end of the pipe read by the reading stage.
+ */
+void	relay_process(t_data *data, t_meter *meter, int in, int out)
+{
+	signal(SIGPIPE, SIG_IGN);
+	if (dup2(in, STDIN_FILENO) == -1 || dup2(out, STDOUT_FILENO) == -1)
+		cleanup_n_exit(ERROR, data);
+	close_inherited(data);
+	run_relay(meter);
+	cleanup_n_exit(0, data);
+}
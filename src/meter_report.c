@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   meter_report.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 15:16:47 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 15:16:47 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Appends the row of one pipe to the table of `print_meters`.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] meter The entry of the pipe.
+ * @param[in] i Index of the pipe.
+ */
+static void	add_meter_row(t_strbuf *sb, t_meter *meter, int i)
+{
+	long	wall;
+	long	rate;
+
+	wall = meter->ended - meter->started;
+	rate = 0;
+	if (wall > 0)
+		rate = meter->bytes * 1000000 / wall;
+	add_col(sb, i + 1, 5);
+	add_col(sb, meter->bytes, 12);
+	add_col(sb, wall, 11);
+	add_col(sb, rate, 12);
+	add_col(sb, meter->read_wait, 12);
+	add_col(sb, meter->write_wait, 13);
+	add_col(sb, meter->splices, 8);
+	sb_add(sb, "\n");
+}
+
+/**
+ * Prints the traffic of every pipe metered with --meter to STDERR.
+ *
+ * One row per metered pipe: the number of bytes relayed, the lifetime of the
+ * relay in us and the resulting throughput in bytes per second. Then come the
+ * time the relay waited for the writing stage to produce data, the time it
+ * waited for the reading stage to make room, which is where the pipeline
+ * stalls, and the number of `splice` calls that moved data.
+ *
+ * @param[in] data Pointer to the t_data structure holding the meters.
+ */
+void	print_meters(t_data *data)
+{
+	t_strbuf	sb;
+	int			i;
+
+	if (!data->meters)
+		return ;
+	ft_bzero(&sb, sizeof(sb));
+	sb_add(&sb, "  pipe        bytes     wall_us  bytes_per_s"
+		" read_wait_us write_wait_us  splices\n");
+	i = 0;
+	while (i < data->cmd_count - 1)
+	{
+		if (data->meters[i].pid > 0)
+			add_meter_row(&sb, &data->meters[i], i);
+		i++;
+	}
+	sb_flush(&sb, STDERR_FILENO);
+}
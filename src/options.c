@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:12:31 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:46:30 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Returns the table of known options.
+ *
+ * Each entry maps an option name to the setter that applies it. New options
+ * are added here. The table ends with a NULL name.
+ *
+ * @return Pointer to the static option table.
+ */
+static const t_option	*option_table(void)
+{
+	static const t_option	table[] = {
+	{"--launcher=", set_launcher},
+	{"--cache", set_cache},
+	{"--no-builtins", set_no_builtins},
+	{"--rewrite", set_rewrite},
+	{"--no-rewrite", set_no_rewrite},
+	{"--print-plan", set_print_plan},
+	{"--pipe-size=", set_pipe_size},
+	{"--jit-pipes", set_jit_pipes},
+	{"--meter", set_meter},
+	{"--meter=", set_meter},
+	{"--parallel=", set_parallel},
+	{"--tee=", set_tee},
+	{"--input=", set_input},
+	{"--merge=", set_merge},
+	{"--batch=", set_batch},
+	{"--jobs=", set_jobs},
+	{"--serve=", set_serve},
+	{"--submit=", set_submit},
+	{"--zygotes=", set_zygotes},
+	{"--cpu-placement=", set_cpu_placement},
+	{"--cpus=", set_cpus},
+	{"--nice=", set_nice},
+	{"--sched=", set_sched},
+	{"--ioprio=", set_ioprio},
+	{"--heredoc-spill=", set_heredoc_spill},
+	{"--heredoc-stream", set_heredoc_stream},
+	{"--pipestatus", set_pipestatus},
+	{"--pipestatus-json=", set_pipestatus_json},
+	{"--stats", set_stats},
+	{"--stats=", set_stats},
+	{"--timeout=", set_timeout},
+	{"--stage-timeout=", set_stage_timeout},
+	{"--kill-after=", set_kill_after},
+	{NULL, NULL}
+	};
+
+	return (table);
+}
+
+/**
+ * Applies a single command line option.
+ *
+ * Looks the argument up in the option table. Names ending in '=' match as a
+ * prefix and receive the rest of the argument as value, other names must
+ * match the whole argument and receive NULL.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] arg The option argument as given on the command line.
+ * @return 0 on success, 1 if the option is unknown or its value is invalid.
+ */
+static int	apply_option(t_opts *opts, char *arg)
+{
+	const t_option	*opt;
+	size_t			len;
+
+	opt = option_table();
+	while (opt->name)
+	{
+		len = ft_strlen(opt->name);
+		if (opt->name[len - 1] == '=' && !ft_strncmp(arg, opt->name, len))
+			return (opt->set(opts, arg + len));
+		if (!ft_strncmp(arg, opt->name, len + 1))
+			return (opt->set(opts, NULL));
+		opt++;
+	}
+	return (1);
+}
+
+/**
+ * Parses the options given before the pipeline arguments.
+ *
+ * Options are the leading arguments starting with "--". Parsing stops at the
+ * first other argument, or after a lone "--". The options structure is reset
+ * to its defaults first. On error a message naming the option is printed to
+ * STDERR.
+ *
+ * @param[in] ac Count of command line arguments.
+ * @param[in] av Array of command line argument strings.
+ * @param[out] opts Options structure to fill.
+ * @return The number of arguments consumed, so that `av + n` can be handled
+ *         like an argument vector without options, or -1 on error.
+ */
+int	parse_options(int ac, char **av, t_opts *opts)
+{
+	int	i;
+
+	ft_bzero(opts, sizeof(*opts));
+	opts->launcher = PIPEX_LAUNCHER;
+	opts->builtins = 1;
+	opts->kill_after = KILL_GRACE_MS;
+	opts->heredoc_spill = HEREDOC_SPILL;
+	i = 1;
+	while (i < ac && av[i][0] == '-' && av[i][1] == '-')
+	{
+		if (av[i][2] == '\0')
+			return (i);
+		if (apply_option(opts, av[i]))
+		{
+			ft_putstr_fd("pipex: invalid option: ", 2);
+			ft_putendl_fd(av[i], 2);
+			return (-1);
+		}
+		opts->given++;
+		i++;
+	}
+	return (i - 1);
+}
+
+/**
+ * Frees the lists built while parsing the options.
+ *
+ * @param[in,out] opts Options structure to release.
+ */
+void	free_options(t_opts *opts)
+{
+	ft_lstclear(&opts->pipe_sizes, free);
+	ft_lstclear(&opts->stage_timeouts, free);
+	ft_lstclear(&opts->meter_edges, free);
+	ft_lstclear(&opts->parallel, free);
+	ft_lstclear(&opts->tees, free);
+	ft_lstclear(&opts->inputs, free);
+	ft_lstclear(&opts->stage_cpus, free);
+	ft_lstclear(&opts->stage_nice, free);
+	ft_lstclear(&opts->stage_sched, free);
+	ft_lstclear(&opts->stage_ioprio, free);
+}
@@ -0,0 +1,46 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_batch.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:04:37 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 19:04:37 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Runs the pipelines of a manifest instead of the pipeline of the command
+ * line, see `run_batch`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Path of the manifest.
+ * @return 0 on success, 1 if the path is empty.
+ */
+int	set_batch(t_opts *opts, char *value)
+{
+	if (!*value)
+		return (1);
+	opts->batch = value;
+	return (0);
+}
+
+/**
+ * Sets how many pipelines of a --batch manifest run at once.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The number of pipelines, at least 1.
+ * @return 0 on success, 1 if the value is not a positive number.
+ */
+int	set_jobs(t_opts *opts, char *value)
+{
+	long	jobs;
+
+	if (parse_positive(&value, '\0', &jobs))
+		return (1);
+	opts->jobs = jobs;
+	return (0);
+}
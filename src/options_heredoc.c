@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_heredoc.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 21:58:10 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 22:48:10 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Sets the size above which the here_doc body moves from memory to an
+ * anonymous temporary file, see `heredoc_write`.
+ *
+ * The size is a number of bytes with an optional K or M suffix, as in
+ * --heredoc-spill=16M.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The size.
+ * @return 0 on success, 1 if the size is invalid.
+ */
+int	set_heredoc_spill(t_opts *opts, char *value)
+{
+	int	size;
+
+	if (parse_size(value, &size) || size == PIPE_SIZE_AUTO)
+		return (1);
+	opts->heredoc_spill = size;
+	return (0);
+}
+
+/**
+ * Feeds the here_doc body to the first stage while it is read, instead of
+ * starting the pipeline once the LIMITER line was read, see
+ * `heredoc_stream`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Unused, the option takes no value.
+ * @return Always 0.
+ */
+int	set_heredoc_stream(t_opts *opts, char *value)
+{
+	(void)value;
+	opts->heredoc_stream = 1;
+	return (0);
+}
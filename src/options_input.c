@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_input.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 17:51:26 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:38:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Adds an input to the pipeline, merged with the infile before the first
+ * stage, see `setup_merge`.
+ *
+ * The value is "FILE" to read a file as is, or "FILE:CMD|CMD..." to run it
+ * through a pipeline of its own first, as in --input=b.log:grep ERROR. The
+ * option may be given more than once, the inputs are merged in the order
+ * given, after the infile. A '|' inside a command is written "\|".
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The file and its optional commands.
+ * @return 0 on success, 1 if the value is invalid or memory runs out.
+ */
+int	set_input(t_opts *opts, char *value)
+{
+	t_input	*input;
+	t_list	*node;
+
+	input = malloc(sizeof(*input));
+	if (!input)
+		return (1);
+	input->file = value;
+	input->cmds = ft_strchr(value, ':');
+	node = NULL;
+	if (*value && value != input->cmds
+		&& (!input->cmds || input->cmds[1]))
+		node = ft_lstnew(input);
+	if (!node)
+	{
+		free(input);
+		return (1);
+	}
+	if (input->cmds)
+		*input->cmds++ = '\0';
+	ft_lstadd_back(&opts->inputs, node);
+	return (0);
+}
+
+/**
+ * Chooses how the infile and the inputs added with --input are merged.
+ *
+ * "concat" reads them one after the other, in order. "interleave" takes one
+ * line of each in turn, until all of them are exhausted. "sorted" merges
+ * inputs that are each sorted byte-wise, as `LC_ALL=C sort`, into a single
+ * sorted stream, like `sort -m`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The name of the policy.
+ * @return 0 on success, 1 if the policy is unknown.
+ */
+int	set_merge(t_opts *opts, char *value)
+{
+	if (!ft_strncmp(value, "concat", 7))
+		opts->merge = MERGE_CONCAT;
+	else if (!ft_strncmp(value, "interleave", 11))
+		opts->merge = MERGE_INTERLEAVE;
+	else if (!ft_strncmp(value, "sorted", 7))
+		opts->merge = MERGE_SORTED;
+	else
+		return (1);
+	return (0);
+}
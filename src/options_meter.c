@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_meter.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 15:02:11 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 15:02:11 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Parses one pipe number of a --meter list and adds it to the list.
+ *
+ * @param[in,out] opts Options structure holding the list.
+ * @param[in] str The text to parse, starting at the number.
+ * @return Length of the number on success, 0 if it is not a valid pipe
+ *         number or memory runs out.
+ */
+static int	add_meter_edge(t_opts *opts, char *str)
+{
+	t_list	*node;
+	int		*edge;
+	long	n;
+	int		i;
+
+	n = 0;
+	i = 0;
+	while (ft_isdigit(str[i]) && n <= INT_MAX)
+		n = n * 10 + str[i++] - '0';
+	if (i == 0 || n < 1 || n > INT_MAX || (str[i] && str[i] != ','))
+		return (0);
+	edge = malloc(sizeof(*edge));
+	if (!edge)
+		return (0);
+	*edge = n;
+	node = ft_lstnew(edge);
+	if (!node)
+	{
+		free(edge);
+		return (0);
+	}
+	ft_lstadd_back(&opts->meter_edges, node);
+	return (i);
+}
+
+/**
+ * Relays pipes through a metering process, see `meter_edge`.
+ *
+ * Without a value every pipe is metered. With --meter=LIST only the pipes in
+ * the comma separated LIST are, 1 being the pipe between the first two
+ * stages of the final plan. The option may be given more than once, the
+ * lists then add up.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The list of pipes, or NULL for every pipe.
+ * @return 0 on success, 1 if the list is invalid or memory runs out.
+ */
+int	set_meter(t_opts *opts, char *value)
+{
+	int	len;
+
+	opts->meter = 1;
+	if (!value)
+		return (0);
+	if (!*value)
+		return (1);
+	while (*value)
+	{
+		len = add_meter_edge(opts, value);
+		if (!len)
+			return (1);
+		value += len;
+		if (*value == ',' && !value[1])
+			return (1);
+		if (*value == ',')
+			value++;
+	}
+	return (0);
+}
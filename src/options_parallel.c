@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_parallel.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 15:48:20 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:54:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Parses a positive number that fits in an int, followed by a given
+ * character.
+ *
+ * @param[in,out] str The text to parse, advanced past the number and the
+ *                    character.
+ * @param[in] end The character expected after the number.
+ * @param[out] num The number.
+ * @return 0 on success, 1 if the text is not a positive number followed by
+ *         `end`.
+ */
+int	parse_positive(char **str, char end, long *num)
+{
+	int	i;
+
+	*num = 0;
+	i = 0;
+	while (ft_isdigit((*str)[i]) && *num <= INT_MAX)
+		*num = *num * 10 + (*str)[i++] - '0';
+	if (i == 0 || (*str)[i] != end || *num < 1 || *num > INT_MAX)
+		return (1);
+	*str += i + (end != '\0');
+	return (0);
+}
+
+/**
+ * Runs one stage as a group of workers, see `run_parallel`.
+ *
+ * The value is "WORKERS:STAGE", as in --parallel=4:2 to run the second stage
+ * of the final plan as 4 workers. The option may be given once per stage,
+ * the last one given wins.
+ *
+ * WORKERS is how many instances of the command run at once, not a set of
+ * long-lived processes: every chunk of about PARALLEL_CHUNK bytes of the
+ * input is run through a new instance, which only ever sees that chunk.
+ * Commands that keep state across lines, such as `sort`, `uniq`, `head` or
+ * `wc`, then give one result per chunk instead of one for the whole input.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The number of workers and the stage.
+ * @return 0 on success, 1 if the value is invalid or memory runs out.
+ */
+int	set_parallel(t_opts *opts, char *value)
+{
+	t_stage_value	*workers;
+	t_list			*node;
+	long			stage;
+
+	workers = malloc(sizeof(*workers));
+	if (!workers)
+		return (1);
+	node = NULL;
+	if (!parse_positive(&value, ':', &workers->value)
+		&& !parse_positive(&value, '\0', &stage))
+	{
+		workers->stage = stage;
+		node = ft_lstnew(workers);
+	}
+	if (!node)
+	{
+		free(workers);
+		return (1);
+	}
+	ft_lstadd_back(&opts->parallel, node);
+	return (0);
+}
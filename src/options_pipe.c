@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_pipe.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:05:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 22:06:30 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Parses a pipe capacity, a number of bytes with an optional K or M suffix,
+ * or "auto". Also used for the size of --heredoc-spill.
+ *
+ * @param[in] str The text to parse.
+ * @param[out] size The capacity in bytes, or PIPE_SIZE_AUTO.
+ * @return 0 on success, 1 if the text is not a valid capacity.
+ */
+int	parse_size(char *str, int *size)
+{
+	long	n;
+	int		shift;
+	int		i;
+
+	*size = PIPE_SIZE_AUTO;
+	if (!ft_strncmp(str, "auto", 5))
+		return (0);
+	n = 0;
+	i = 0;
+	while (ft_isdigit(str[i]) && n <= INT_MAX)
+		n = n * 10 + str[i++] - '0';
+	shift = 0;
+	if (str[i] == 'K' || str[i] == 'k')
+		shift = 10;
+	else if (str[i] == 'M' || str[i] == 'm')
+		shift = 20;
+	if (shift)
+		i++;
+	if (str[i] || !ft_isdigit(str[0]) || n > INT_MAX)
+		return (1);
+	n <<= shift;
+	if (n <= 0 || n > INT_MAX)
+		return (1);
+	*size = n;
+	return (0);
+}
+
+/**
+ * Parses the pipe number in front of a per-pipe capacity, as in "2:1M".
+ *
+ * @param[in] str The text to parse, ending at the ':'.
+ * @param[out] edge The pipe number, counting from 1.
+ * @return 0 on success, 1 if the text is not a valid pipe number.
+ */
+static int	parse_edge(char *str, int *edge)
+{
+	long	n;
+	int		i;
+
+	n = 0;
+	i = 0;
+	while (ft_isdigit(str[i]) && n <= INT_MAX)
+		n = n * 10 + str[i++] - '0';
+	if (i == 0 || str[i] != ':' || n < 1 || n > INT_MAX)
+		return (1);
+	*edge = n;
+	return (0);
+}
+
+/**
+ * Requests a capacity for the pipes of the pipeline.
+ *
+ * Accepts "SIZE" for every pipe and "EDGE:SIZE" for a single one, EDGE being
+ * 1 for the pipe between the first two stages of the final plan. SIZE is a
+ * number of bytes with an optional K or M suffix, or "auto" to derive it from
+ * the size of the input file. The option may be given more than once, a
+ * per-pipe size wins over a size for every pipe and the last one given wins
+ * otherwise.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The requested size.
+ * @return 0 on success, 1 if the value is invalid or memory runs out.
+ */
+int	set_pipe_size(t_opts *opts, char *value)
+{
+	t_pipe_size	*pipe_size;
+	t_list		*node;
+	char		*colon;
+
+	pipe_size = malloc(sizeof(*pipe_size));
+	if (!pipe_size)
+		return (1);
+	pipe_size->edge = 0;
+	colon = ft_strchr(value, ':');
+	node = NULL;
+	if (colon && !parse_edge(value, &pipe_size->edge))
+		value = colon + 1;
+	if ((!colon || value == colon + 1)
+		&& !parse_size(value, &pipe_size->size))
+		node = ft_lstnew(pipe_size);
+	if (!node)
+	{
+		free(pipe_size);
+		return (1);
+	}
+	ft_lstadd_back(&opts->pipe_sizes, node);
+	return (0);
+}
+
+/**
+ * Creates each pipe right before the stage writing to it is launched, see
+ * `open_next_pipe`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Unused, the option takes no value.
+ * @return Always 0.
+ */
+int	set_jit_pipes(t_opts *opts, char *value)
+{
+	(void)value;
+	opts->jit_pipes = 1;
+	return (0);
+}
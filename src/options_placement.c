@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_placement.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:52:30 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 20:52:30 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Pins every stage to a CPU of its own, see `plan_placement`.
+ *
+ * "compact" places adjacent stages on adjacent CPUs of the topology, SMT
+ * siblings first, then cores of the same package, so that the pipes between
+ * them stay in a shared cache. "spread" places the stages as far apart as
+ * the CPUs allow. "none" leaves the placement to the scheduler.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The policy.
+ * @return 0 on success, 1 if the policy is unknown.
+ */
+int	set_cpu_placement(t_opts *opts, char *value)
+{
+	if (!ft_strncmp(value, "compact", 8))
+		opts->placement = PLACE_COMPACT;
+	else if (!ft_strncmp(value, "spread", 7))
+		opts->placement = PLACE_SPREAD;
+	else if (!ft_strncmp(value, "none", 5))
+		opts->placement = PLACE_NONE;
+	else
+		return (1);
+	return (0);
+}
+
+/**
+ * Parses a CPU number of a CPU list.
+ *
+ * @param[in,out] str The text to parse, advanced past the number.
+ * @param[out] cpu The CPU number.
+ * @return 0 on success, 1 if there is no number or it is out of range.
+ */
+static int	parse_cpu(char **str, int *cpu)
+{
+	int	i;
+
+	*cpu = 0;
+	i = 0;
+	while (ft_isdigit((*str)[i]) && *cpu < CPU_SETSIZE)
+		*cpu = *cpu * 10 + (*str)[i++] - '0';
+	*str += i;
+	return (i == 0 || *cpu >= CPU_SETSIZE);
+}
+
+/**
+ * Parses a CPU list in the format of the kernel, as in "0-3,8,10-11".
+ *
+ * @param[in] str The text to parse.
+ * @param[out] cpus The CPUs of the list.
+ * @return 0 on success, 1 if the list is invalid.
+ */
+static int	parse_cpu_list(char *str, cpu_set_t *cpus)
+{
+	int	first;
+	int	last;
+
+	CPU_ZERO(cpus);
+	while (1)
+	{
+		if (parse_cpu(&str, &first))
+			return (1);
+		last = first;
+		if (*str == '-')
+		{
+			str++;
+			if (parse_cpu(&str, &last) || last < first)
+				return (1);
+		}
+		while (first <= last)
+			CPU_SET(first++, cpus);
+		if (*str == '\0')
+			return (0);
+		if (*str++ != ',')
+			return (1);
+	}
+}
+
+/**
+ * Pins a single stage to a list of CPUs.
+ *
+ * The value is "STAGE:LIST", as in --cpus=2:0-1 to run the second stage of
+ * the final plan on the first two CPUs. The CPUs of a stage win over
+ * --cpu-placement. The option may be given once per stage, the last one
+ * given wins.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The stage and the CPU list.
+ * @return 0 on success, 1 if the value is invalid or memory runs out.
+ */
+int	set_cpus(t_opts *opts, char *value)
+{
+	t_stage_cpus	*cpus;
+	t_list			*node;
+	long			stage;
+
+	cpus = malloc(sizeof(*cpus));
+	if (!cpus)
+		return (1);
+	node = NULL;
+	if (!parse_positive(&value, ':', &stage)
+		&& !parse_cpu_list(value, &cpus->cpus))
+	{
+		cpus->stage = stage;
+		node = ft_lstnew(cpus);
+	}
+	if (!node)
+	{
+		free(cpus);
+		return (1);
+	}
+	ft_lstadd_back(&opts->stage_cpus, node);
+	return (0);
+}
@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_priority.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 21:31:10 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 21:31:10 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Allocates the value of a per-stage priority option and reads its stage.
+ *
+ * The value is "STAGE:SETTING" for one stage, STAGE being 1 for the first
+ * stage of the final plan, or "SETTING" for every stage without a setting of
+ * its own.
+ *
+ * @param[in,out] value The option value, advanced past the stage.
+ * @return The new entry, or NULL if the stage is invalid or memory runs out.
+ */
+static t_stage_value	*new_priority(char **value)
+{
+	t_stage_value	*prio;
+	long			stage;
+
+	prio = ft_calloc(1, sizeof(*prio));
+	if (!prio)
+		return (NULL);
+	if (ft_strchr(*value, ':'))
+	{
+		if (parse_positive(value, ':', &stage))
+		{
+			free(prio);
+			return (NULL);
+		}
+		prio->stage = stage;
+	}
+	return (prio);
+}
+
+/**
+ * Adds a parsed priority to its option list, or releases it.
+ *
+ * @param[in,out] list The option list.
+ * @param[in] prio The entry.
+ * @param[in] valid Non-zero if the setting of the entry was valid.
+ * @return 0 on success, 1 if the setting is invalid or memory runs out.
+ */
+static int	keep_priority(t_list **list, t_stage_value *prio, int valid)
+{
+	t_list	*node;
+
+	node = NULL;
+	if (valid)
+		node = ft_lstnew(prio);
+	if (!node)
+	{
+		free(prio);
+		return (1);
+	}
+	ft_lstadd_back(list, node);
+	return (0);
+}
+
+/**
+ * Sets the nice value stages run with, from -20 to 19, as in --nice=3:10 to
+ * run the third stage of the final plan at nice 10. The value is absolute,
+ * not added to the one of pipex.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The nice value, with an optional stage number.
+ * @return 0 on success, 1 if the value is invalid or memory runs out.
+ */
+int	set_nice(t_opts *opts, char *value)
+{
+	t_stage_value	*prio;
+	char			*digits;
+	long			nice;
+
+	prio = new_priority(&value);
+	if (!prio)
+		return (1);
+	digits = value + (*value == '-' || *value == '+');
+	nice = 0;
+	while (ft_isdigit(*digits) && nice <= 20)
+		nice = nice * 10 + *digits++ - '0';
+	if (*value == '-')
+		nice = -nice;
+	prio->value = nice;
+	return (keep_priority(&opts->stage_nice, prio, *digits == '\0'
+			&& ft_isdigit(digits[-1]) && nice >= -20 && nice <= 19));
+}
+
+/**
+ * Sets the scheduling policy stages run with, "batch" for SCHED_BATCH,
+ * "idle" for SCHED_IDLE or "other" for the default policy.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The policy, with an optional stage number.
+ * @return 0 on success, 1 if the value is invalid or memory runs out.
+ */
+int	set_sched(t_opts *opts, char *value)
+{
+	t_stage_value	*prio;
+
+	prio = new_priority(&value);
+	if (!prio)
+		return (1);
+	prio->value = -1;
+	if (!ft_strncmp(value, "batch", 6))
+		prio->value = SCHED_BATCH;
+	else if (!ft_strncmp(value, "idle", 5))
+		prio->value = SCHED_IDLE;
+	else if (!ft_strncmp(value, "other", 6))
+		prio->value = SCHED_OTHER;
+	return (keep_priority(&opts->stage_sched, prio, prio->value != -1));
+}
+
+/**
+ * Sets the I/O priority stages run with, "idle", or "be" or "rt" with an
+ * optional level from 0, the highest, to 7, as in --ioprio=2:be,7. The level
+ * defaults to 4, the one of a process at nice 0.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The class and level, with an optional stage number.
+ * @return 0 on success, 1 if the value is invalid or memory runs out.
+ */
+int	set_ioprio(t_opts *opts, char *value)
+{
+	t_stage_value	*prio;
+	long			class;
+	long			level;
+
+	prio = new_priority(&value);
+	if (!prio)
+		return (1);
+	class = 0;
+	if (!ft_strncmp(value, "rt", 2) || !ft_strncmp(value, "be", 2))
+		class = 1 + (value[0] == 'b');
+	else if (!ft_strncmp(value, "idle", 4))
+		class = 3;
+	value += 2 + 2 * (class == 3);
+	level = 4 * (class != 3);
+	if (class && class != 3 && *value == ',' && ft_isdigit(value[1]))
+	{
+		level = value[1] - '0';
+		value += 2;
+	}
+	prio->value = class << IOPRIO_SHIFT | level;
+	return (keep_priority(&opts->stage_ioprio, prio, class && *value == '\0'
+			&& level < 8));
+}
@@ -0,0 +1,66 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_report.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:02:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 14:40:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Prints the exit code of every stage once the pipeline is done, see
+ * `print_pipestatus`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Unused, the option takes no value.
+ * @return Always 0.
+ */
+int	set_pipestatus(t_opts *opts, char *value)
+{
+	(void)value;
+	opts->pipestatus = 1;
+	return (0);
+}
+
+/**
+ * Writes the exit status of every stage to a JSON file once the pipeline is
+ * done, see `write_pipestatus_json`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Path of the file to write.
+ * @return 0 on success, 1 if the path is empty.
+ */
+int	set_pipestatus_json(t_opts *opts, char *value)
+{
+	if (!*value)
+		return (1);
+	opts->pipestatus_json = value;
+	return (0);
+}
+
+/**
+ * Reports the resources used by every stage once the pipeline is done.
+ *
+ * Without a value a table is printed to STDERR, see `print_stats`. With
+ * --stats=FILE the same figures are written to FILE as JSON, see
+ * `write_stats_json`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Path of the JSON file, or NULL for the table.
+ * @return 0 on success, 1 if the path is empty.
+ */
+int	set_stats(t_opts *opts, char *value)
+{
+	if (value && !*value)
+		return (1);
+	if (value)
+		opts->stats_file = value;
+	else
+		opts->stats = 1;
+	return (0);
+}
@@ -0,0 +1,43 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_rewrite.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:05:10 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:05:10 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Enables the rewrite pass, which drops stages that only copy their input,
+ * see `rewrite_stages`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Unused, the option takes no value.
+ * @return Always 0.
+ */
+int	set_rewrite(t_opts *opts, char *value)
+{
+	(void)value;
+	opts->rewrite = 1;
+	return (0);
+}
+
+/**
+ * Disables the rewrite pass, so every command given runs as its own stage.
+ * This is the default.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Unused, the option takes no value.
+ * @return Always 0.
+ */
+int	set_no_rewrite(t_opts *opts, char *value)
+{
+	(void)value;
+	opts->rewrite = 0;
+	return (0);
+}
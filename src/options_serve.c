@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_serve.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:40:18 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:46:30 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Runs as a server accepting pipelines on a Unix socket instead of running
+ * the pipeline of the command line, see `run_serve`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Path of the socket.
+ * @return 0 on success, 1 if the path is empty.
+ */
+int	set_serve(t_opts *opts, char *value)
+{
+	if (!*value)
+		return (1);
+	opts->serve = value;
+	return (0);
+}
+
+/**
+ * Runs the pipeline of the command line on a server started with --serve,
+ * see `submit_job`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Path of the socket of the server.
+ * @return 0 on success, 1 if the path is empty.
+ */
+int	set_submit(t_opts *opts, char *value)
+{
+	if (!*value)
+		return (1);
+	opts->submit = value;
+	return (0);
+}
+
+/**
+ * Rejects the options given along with --submit.
+ *
+ * The pipeline runs on the server with the options the server was started
+ * with, so any other option would be silently dropped.
+ *
+ * @param[in] opts Options parsed from the command line.
+ * @return 1 if --submit was given with other options, after a message is
+ *         printed to STDERR, 0 otherwise.
+ */
+int	check_submit(t_opts *opts)
+{
+	if (!opts->submit || opts->given == 1)
+		return (0);
+	ft_putendl_fd("pipex: --submit: other options are taken by --serve", 2);
+	return (1);
+}
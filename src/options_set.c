@@ -0,0 +1,78 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_set.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:30:12 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:08:40 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Sets the launcher used to start pipeline stages.
+ *
+ * Accepts "fork", which forks a copy of pipex for every stage before calling
+ * `execve`, and "spawn", which starts stages with `posix_spawn`. The spawn
+ * launcher avoids copying the page tables of the parent for every stage,
+ * which matters for long pipelines and large parents.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Name of the launcher.
+ * @return 0 on success, 1 if the launcher name is unknown.
+ */
+int	set_launcher(t_opts *opts, char *value)
+{
+	if (!ft_strncmp(value, "fork", 5))
+		opts->launcher = LAUNCH_FORK;
+	else if (!ft_strncmp(value, "spawn", 6))
+		opts->launcher = LAUNCH_SPAWN;
+	else
+		return (1);
+	return (0);
+}
+
+/**
+ * Enables the on-disk command resolution cache.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Unused, the option takes no value.
+ * @return Always 0.
+ */
+int	set_cache(t_opts *opts, char *value)
+{
+	(void)value;
+	opts->cache = 1;
+	return (0);
+}
+
+/**
+ * Disables the builtin stages, so every command runs its external binary.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Unused, the option takes no value.
+ * @return Always 0.
+ */
+int	set_no_builtins(t_opts *opts, char *value)
+{
+	(void)value;
+	opts->builtins = 0;
+	return (0);
+}
+
+/**
+ * Prints the stages that will run, after the rewrite pass, to STDERR.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value Unused, the option takes no value.
+ * @return Always 0.
+ */
+int	set_print_plan(t_opts *opts, char *value)
+{
+	(void)value;
+	opts->print_plan = 1;
+	return (0);
+}
@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_tee.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 16:58:09 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:38:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Sends the output of a stage to a second pipeline as well.
+ *
+ * The value is "STAGE:OUTFILE:CMD|CMD...", as in --tee=1:count.txt:wc -l to
+ * count the lines the first stage of the final plan writes, while they still
+ * flow to the second stage. STAGE may be the last stage, whose output then
+ * goes to both outfiles. The branch may hold one or more commands, a '|'
+ * inside a command being written "\|", and the option may be given more
+ * than once, for the same stage or others.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The stage, the outfile and the commands of the branch.
+ * @return 0 on success, 1 if the value is invalid or memory runs out.
+ */
+int	set_tee(t_opts *opts, char *value)
+{
+	t_tee	*tee;
+	t_list	*node;
+	long	stage;
+
+	stage = 0;
+	while (ft_isdigit(*value) && stage <= INT_MAX)
+		stage = stage * 10 + *value++ - '0';
+	if (*value++ != ':' || stage < 1 || stage > INT_MAX)
+		return (1);
+	tee = ft_calloc(1, sizeof(*tee));
+	if (!tee)
+		return (1);
+	tee->stage = stage;
+	tee->outfile = value;
+	tee->cmds = ft_strchr(value, ':');
+	node = NULL;
+	if (tee->cmds && tee->cmds != value && tee->cmds[1])
+		node = ft_lstnew(tee);
+	if (node)
+		*tee->cmds++ = '\0';
+	else
+		free(tee);
+	ft_lstadd_back(&opts->tees, node);
+	return (node == NULL);
+}
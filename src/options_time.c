@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_time.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:50:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 13:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Parses a duration in seconds into ms, decimals past the ms are ignored.
+ *
+ * @param[in] str The text to parse, as in "30" or "0.25".
+ * @param[out] ms The duration in ms.
+ * @return 0 on success, 1 if the text is not a valid positive duration.
+ */
+static int	parse_ms(char *str, long *ms)
+{
+	long	scale;
+	int		i;
+
+	*ms = 0;
+	i = 0;
+	while (ft_isdigit(str[i]) && *ms < LONG_MAX / 10000)
+		*ms = *ms * 10 + str[i++] - '0';
+	if (i == 0)
+		return (1);
+	*ms *= 1000;
+	scale = 100;
+	if (str[i] == '.' && ft_isdigit(str[i + 1]))
+	{
+		i++;
+		while (ft_isdigit(str[i]))
+		{
+			*ms += (str[i++] - '0') * scale;
+			scale /= 10;
+		}
+	}
+	return (str[i] != '\0' || *ms <= 0);
+}
+
+/**
+ * Limits the time the whole pipeline may run.
+ *
+ * Once the limit is reached every stage still running is sent SIGTERM, then
+ * SIGKILL if it did not exit within --kill-after, and pipex exits with
+ * TIMEOUT_STATUS.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The limit in seconds.
+ * @return 0 on success, 1 if the value is invalid.
+ */
+int	set_timeout(t_opts *opts, char *value)
+{
+	return (parse_ms(value, &opts->timeout));
+}
+
+/**
+ * Limits the time single stages may run, counted from their start.
+ *
+ * Accepts "SECS" for every stage and "STAGE:SECS" for one stage, STAGE being
+ * 1 for the first stage of the final plan. A limit for the stage wins over a
+ * limit for every stage. A stage past its limit is stopped like with
+ * --timeout.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The limit, with an optional stage number.
+ * @return 0 on success, 1 if the value is invalid or memory runs out.
+ */
+int	set_stage_timeout(t_opts *opts, char *value)
+{
+	t_stage_value	*limit;
+	t_list			*node;
+
+	limit = ft_calloc(1, sizeof(*limit));
+	if (!limit)
+		return (1);
+	if (ft_strchr(value, ':'))
+	{
+		while (ft_isdigit(*value) && limit->stage < 100000000)
+			limit->stage = limit->stage * 10 + *value++ - '0';
+		if (*value++ != ':' || limit->stage < 1)
+			limit->value = -1;
+	}
+	node = NULL;
+	if (limit->value == 0 && !parse_ms(value, &limit->value))
+		node = ft_lstnew(limit);
+	if (!node)
+	{
+		free(limit);
+		return (1);
+	}
+	ft_lstadd_back(&opts->stage_timeouts, node);
+	return (0);
+}
+
+/**
+ * Sets the time between SIGTERM and SIGKILL for a stage past its deadline.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The delay in seconds.
+ * @return 0 on success, 1 if the value is invalid.
+ */
+int	set_kill_after(t_opts *opts, char *value)
+{
+	return (parse_ms(value, &opts->kill_after));
+}
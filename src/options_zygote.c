@@ -0,0 +1,30 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_zygote.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:24:10 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 20:24:10 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Forks helper processes ahead of the stages, see `start_zygotes`.
+ *
+ * @param[out] opts Options structure to update.
+ * @param[in] value The number of helpers, at least 1.
+ * @return 0 on success, 1 if the value is not a positive number.
+ */
+int	set_zygotes(t_opts *opts, char *value)
+{
+	long	zygotes;
+
+	if (parse_positive(&value, '\0', &zygotes))
+		return (1);
+	opts->zygotes = zygotes;
+	return (0);
+}
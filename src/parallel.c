@@ -0,0 +1,173 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parallel.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 15:55:03 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:54:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Looks up the number of workers requested for a stage with --parallel.
+ *
+ * @param[in] data Pointer to the t_data structure holding the options.
+ * @param[in] stage Number of the stage, counting from 1.
+ * @return The number of workers, or 0 if none was requested.
+ */
+static int	stage_workers(t_data *data, int stage)
+{
+	t_list			*node;
+	t_stage_value	*workers;
+	int				count;
+
+	count = 0;
+	node = data->opts.parallel;
+	while (node)
+	{
+		workers = node->content;
+		if (workers->stage == stage)
+			count = workers->value;
+		node = node->next;
+	}
+	return (count);
+}
+
+/**
+ * Assigns the workers requested with --parallel to the stages of the final
+ * plan.
+ *
+ * Only stages that execute a command are run in parallel. A builtin keeps
+ * running in a single process, and a command that was not found fails like
+ * it does without the option.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ */
+void	plan_workers(t_data *data)
+{
+	t_stage	*stage;
+	int		i;
+
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		stage = &data->stages[i];
+		stage->workers = stage_workers(data, i + 1);
+		if (stage->workers < 2 || stage->builtin || !stage->path)
+			stage->workers = 0;
+		i++;
+	}
+}
+
+/**
+ * Waits for the workers still running once the input is exhausted and writes
+ * their outputs, oldest chunk first.
+ *
+ * @param[in,out] par State of the stage.
+ * @param[in] seq Sequence number of the next chunk that would have been
+ *                started, the oldest running chunk being `seq - count`.
+ * @return 0 on success, 1 if an output could not be written.
+ */
+static int	drain_workers(t_parallel *par, long seq)
+{
+	long	i;
+	int		err;
+
+	err = 0;
+	i = seq;
+	while (i < seq + par->count)
+	{
+		if (par->slots[i % par->count].pid > 0)
+			err |= finish_worker(par, &par->slots[i % par->count]);
+		i++;
+	}
+	return (err);
+}
+
+/**
+ * Feeds the input to the workers chunk by chunk.
+ *
+ * Chunk n goes to slot n % count. A slot is reused only once the worker
+ * holding chunk n - count exited and its output was written, which is
+ * always the oldest chunk still pending, so the outputs are written in the
+ * order of the input while the other workers keep running. The next chunk is
+ * read before waiting, so reading overlaps with the workers. At least one
+ * worker is started, on an empty input if need be, so that commands that
+ * print something on empty input behave as usual.
+ *
+ * @param[in,out] par State of the stage.
+ * @return 0 on success, 1 on error.
+ */
+static int	feed_workers(t_parallel *par)
+{
+	t_worker	*slot;
+	ssize_t		len;
+	long		seq;
+	int			err;
+
+	err = 0;
+	seq = 0;
+	while (!err && (seq == 0 || !par->eof || par->len > 0))
+	{
+		len = next_chunk(par);
+		slot = &par->slots[seq % par->count];
+		if (slot->pid > 0)
+			err |= finish_worker(par, slot);
+		if (len < 0 || err)
+			return (1);
+		err |= start_worker(par, slot, len);
+		seq++;
+	}
+	return (err | drain_workers(par, seq));
+}
+
+/**
+ * Runs a stage as a group of workers, in the child forked for the stage.
+ *
+ * CPU-bound filters such as `grep -E` or a transform script only use one
+ * core in a pipeline. With --parallel the process of the stage becomes a
+ * dispatcher instead: the input is split on line boundaries into chunks of
+ * about PARALLEL_CHUNK bytes, each chunk is run through its own instance of
+ * the command, up to `count` of them at once, and the outputs are written in
+ * the order of the input. The workers are children of the dispatcher, so
+ * the stage keeps a single process ID for the reaper, deadlines and
+ * --stats, which accounts for the workers through `wait4`. A new instance is
+ * started for every chunk, it never sees the rest of the input, so this
+ * only suits commands that treat every line on its own, see `set_parallel`.
+ * Keeping long-lived workers instead would lose the order of the outputs,
+ * which cannot be told apart once they share a stream.
+ *
+ * The exit code is the first one above 1 returned by a worker, as an error
+ * of grep, else 0 if a worker returned 0, else 1.
+ *
+ * @param[in] stage The stage to run.
+ * @param[in] count Number of workers.
+ * @param[in] envp Environment passed to the workers.
+ * @return The exit code of the stage.
+ */
+int	run_parallel(t_stage *stage, int count, char **envp)
+{
+	t_parallel	par;
+	int			err;
+
+	ft_bzero(&par, sizeof(par));
+	par.stage = stage;
+	par.envp = envp;
+	par.count = count;
+	par.status = -1;
+	par.size = 2 * PARALLEL_CHUNK;
+	par.slots = ft_calloc(count, sizeof(*par.slots));
+	par.buf = malloc(par.size);
+	err = 1;
+	if (par.slots && par.buf)
+		err = feed_workers(&par);
+	free(par.slots);
+	free(par.buf);
+	if (err || par.status == -1)
+		return (ERROR);
+	return (par.status);
+}
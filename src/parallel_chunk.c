@@ -0,0 +1,153 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parallel_chunk.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 16:02:37 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:54:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Doubles the ring buffer of a parallel stage once it is full, moving the
+ * pending input to the start of the new buffer.
+ *
+ * @param[in,out] par State of the stage.
+ * @return 0 on success, 1 if memory runs out.
+ */
+static int	grow_buffer(t_parallel *par)
+{
+	char	*buf;
+	size_t	first;
+
+	buf = malloc(par->size * 2);
+	if (!buf)
+		return (1);
+	first = par->size - par->head;
+	ft_memcpy(buf, par->buf + par->head, first);
+	ft_memcpy(buf + first, par->buf, par->head);
+	free(par->buf);
+	par->buf = buf;
+	par->head = 0;
+	par->size *= 2;
+	return (0);
+}
+
+/**
+ * Reads more of the standard input into the ring buffer of a parallel
+ * stage, growing the buffer when it is full.
+ *
+ * @param[in,out] par State of the stage.
+ * @return 0 on success, 1 on error.
+ */
+static int	fill_buffer(t_parallel *par)
+{
+	ssize_t	n;
+	size_t	tail;
+	size_t	room;
+
+	if (par->len == par->size && grow_buffer(par))
+		return (1);
+	tail = (par->head + par->len) % par->size;
+	room = par->size - par->len;
+	if (tail + room > par->size)
+		room = par->size - tail;
+	n = read(STDIN_FILENO, par->buf + tail, room);
+	if (n < 0 && errno != EINTR)
+		return (1);
+	if (n == 0)
+		par->eof = 1;
+	if (n > 0)
+		par->len += n;
+	return (0);
+}
+
+/**
+ * Looks for a newline in the pending input of a parallel stage, which may
+ * wrap around the end of the ring buffer.
+ *
+ * @param[in] par State of the stage.
+ * @param[in] from Offset in the pending input to start from.
+ * @return The offset of the newline in the pending input, or -1 if there is
+ *         none past `from`.
+ */
+static ssize_t	find_newline(t_parallel *par, size_t from)
+{
+	char	*nl;
+	size_t	start;
+	size_t	first;
+
+	start = (par->head + from) % par->size;
+	first = par->len - from;
+	if (start + first > par->size)
+		first = par->size - start;
+	nl = ft_memchr(par->buf + start, '\n', first);
+	if (nl)
+		return (from + (nl - (par->buf + start)));
+	nl = ft_memchr(par->buf, '\n', par->len - from - first);
+	if (nl)
+		return (from + first + (nl - par->buf));
+	return (-1);
+}
+
+/**
+ * Reads the next chunk of the input of a parallel stage.
+ *
+ * A chunk is the first PARALLEL_CHUNK bytes of the pending input, extended
+ * up to the end of the line they stop in, so that no line is ever split
+ * between two workers. At end of file the last chunk is whatever is left.
+ *
+ * @param[in,out] par State of the stage.
+ * @return The length of the chunk, at the start of the pending input, or -1
+ *         on error.
+ */
+ssize_t	next_chunk(t_parallel *par)
+{
+	ssize_t	nl;
+	size_t	scan;
+
+	scan = PARALLEL_CHUNK - 1;
+	while (1)
+	{
+		if (par->len > scan)
+		{
+			nl = find_newline(par, scan);
+			if (nl >= 0)
+				return (nl + 1);
+			scan = par->len;
+		}
+		if (par->eof)
+			return (par->len);
+		if (fill_buffer(par))
+			return (-1);
+	}
+}
+
+/**
+ * Writes the chunk at the start of the pending input to a file and drops
+ * it from the ring buffer, which only moves its start.
+ *
+ * @param[in,out] par State of the stage.
+ * @param[in] fd The file.
+ * @param[in] len Length of the chunk.
+ * @return 0 on success, 1 on error.
+ */
+int	take_chunk(t_parallel *par, int fd, size_t len)
+{
+	size_t	first;
+	int		err;
+
+	first = len;
+	if (par->head + first > par->size)
+		first = par->size - par->head;
+	err = write_all(fd, par->buf + par->head, first);
+	if (!err && first < len)
+		err = write_all(fd, par->buf, len - first);
+	par->head = (par->head + len) % par->size;
+	par->len -= len;
+	return (err);
+}
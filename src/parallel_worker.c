@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parallel_worker.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 16:20:14 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:54:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Starts the command of a parallel stage, reading from and writing to memory
+ * files.
+ *
+ * The worker is forked rather than spawned so that it can ask to be killed
+ * when the dispatcher dies. A dispatcher stopped by --timeout, by SIGPIPE
+ * or from the terminal then takes its workers with it instead of leaving
+ * them running on their chunks.
+ *
+ * @param[in] par State of the stage.
+ * @param[in,out] slot The slot of the worker, holding its output file and
+ *                     receiving its process ID.
+ * @param[in] in The memory file holding the chunk.
+ * @return 0 on success, 1 if the worker could not be forked.
+ */
+static int	spawn_worker(t_parallel *par, t_worker *slot, int in)
+{
+	pid_t	parent;
+
+	parent = getpid();
+	slot->pid = fork();
+	if (slot->pid == -1)
+		return (1);
+	if (slot->pid == 0)
+	{
+		if (prctl(PR_SET_PDEATHSIG, SIGKILL) == -1 || getppid() != parent
+			|| dup2(in, STDIN_FILENO) == -1
+			|| dup2(slot->out, STDOUT_FILENO) == -1)
+			exit(ERROR);
+		execve(par->stage->path, par->stage->argv, par->envp);
+		ft_printf("pipex: %s: %s\n", par->stage->argv[0], strerror(errno));
+		exit(ERROR);
+	}
+	return (0);
+}
+
+/**
+ * Starts a worker on the chunk at the start of the pending input, which
+ * `take_chunk` removes from the buffer.
+ *
+ * The chunk is written to a memory file the worker reads as its standard
+ * input, and the worker writes to another memory file, so the dispatcher
+ * never blocks on a worker and a worker never blocks on the next stage.
+ *
+ * @param[in,out] par State of the stage.
+ * @param[out] slot The slot the worker runs in, free.
+ * @param[in] len Length of the chunk.
+ * @return 0 on success, 1 on error.
+ */
+int	start_worker(t_parallel *par, t_worker *slot, size_t len)
+{
+	int	in;
+	int	err;
+
+	in = memfd_create("pipex-chunk", MFD_CLOEXEC);
+	slot->out = memfd_create("pipex-output", MFD_CLOEXEC);
+	err = (in == -1 || slot->out == -1 || take_chunk(par, in, len)
+			|| lseek(in, 0, SEEK_SET) == -1
+			|| spawn_worker(par, slot, in));
+	if (in != -1)
+		close(in);
+	if (err)
+	{
+		ft_printf("pipex: %s: worker error: %s\n", par->stage->argv[0],
+			strerror(errno));
+		slot->pid = 0;
+	}
+	return (err);
+}
+
+/**
+ * Merges the exit code of a worker into the exit code of the stage.
+ *
+ * @param[in,out] par State of the stage.
+ * @param[in] status Wait status of the worker.
+ */
+static void	merge_status(t_parallel *par, int status)
+{
+	int	code;
+
+	code = 128 + WTERMSIG(status);
+	if (WIFEXITED(status))
+		code = WEXITSTATUS(status);
+	if (par->status == -1 || (code > 1 && par->status <= 1)
+		|| (code == 0 && par->status == 1))
+		par->status = code;
+}
+
+/**
+ * Waits for the worker of a slot and writes its output to the standard
+ * output, then frees the slot.
+ *
+ * The output is moved from its memory file to the pipe with `sendfile`,
+ * without copying it through the dispatcher.
+ *
+ * @param[in,out] par State of the stage.
+ * @param[in,out] slot The slot of the worker.
+ * @return 0 on success, 1 if the output could not be written.
+ */
+int	finish_worker(t_parallel *par, t_worker *slot)
+{
+	struct stat	st;
+	off_t		off;
+	ssize_t		n;
+	int			status;
+
+	if (waitpid(slot->pid, &status, 0) == slot->pid)
+		merge_status(par, status);
+	slot->pid = 0;
+	off = 0;
+	n = -1;
+	if (fstat(slot->out, &st) == 0)
+		n = 1;
+	while (n > 0 && off < st.st_size)
+		n = sendfile(STDOUT_FILENO, slot->out, &off, st.st_size - off);
+	close(slot->out);
+	slot->out = -1;
+	return (n <= 0);
+}
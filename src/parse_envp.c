@@ -6,7 +6,7 @@
 /*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/22 00:39:50 by fde-alen          #+#    #+#             */
-/*   Updated: 2024/01/22 03:04:55 by fde-alen         ###   ########.fr       */
+/*   Updated: 2026/10/16 19:21:30 by fde-alen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -63,7 +63,7 @@ static char	*extract_path_var(char**envp)
  * @return An array of strings, each representing a path from the PATH
  * environment variable with a '/' appended, or NULL if any allocation fails.
  */
-static char	**get_env_paths(char**envp)
+char	**get_env_paths(char**envp)
 {
 	char	*env_path_str;
 	char	**paths;
@@ -96,34 +96,36 @@ static char	**get_env_paths(char**envp)
 * This function takes a command name and an array of directory paths, then
 * iterates through each directory to check if the command exists and is
 * executable within that directory. It constructs the full path of the command
-* by joining the directory path with the command name.
+* by joining the directory path with the command name. For long pipelines the
+* PATH index answers first, and the directories are only probed one by one
+* when the index cannot.
 *
 * @param cmd The command name to search for.
-* @param paths An array of directory paths to search the command in.
+* @param data Pointer to a t_data structure holding the parsed PATH
+*             directories.
 * @return A dynamically allocated string containing the full path to the
 *         command if found, otherwise returns NULL. The caller is responsible
 *         for freeing this string.
 *
-* Note: If the command is not found in any of the provided paths, or if there
-*       is an error during path construction, the function returns NULL. If an
-*       error occurs, the function also frees the paths array and exits with an
-*       error message.
+* Note: If the command is not found in any of the provided paths, the function
+*       returns NULL. If an error occurs during path construction, the
+*       function exits with an error message.
 */
-static char	*get_cmd_path(char*cmd, char**paths)
+static char	*get_cmd_path(char*cmd, t_data*data)
 {
 	int		i;
 	char	*cmd_path;
 
-	cmd_path = NULL;
+	if (path_index_find(data, cmd, &cmd_path))
+		return (cmd_path);
 	i = 0;
-	while (paths[i])
+	while (data->paths[i])
 	{
-		cmd_path = ft_strjoin(paths[i], cmd);
+		cmd_path = ft_strjoin(data->paths[i], cmd);
 		if (!cmd_path)
 		{
-			free_array(paths);
 			ft_printf("pipex: cmd_path error\n");
-			cleanup_n_exit(ERROR, NULL);
+			cleanup_n_exit(ERROR, data);
 		}
 		if (access(cmd_path, F_OK | X_OK) == 0)
 			return (cmd_path);
@@ -135,32 +137,59 @@ static char	*get_cmd_path(char*cmd, char**paths)
 }
 
 /**
-* Retrieves the full path of a command executable.
+* Resolves the full path of a command executable, without reporting it.
 *
 * This function checks if the given command can be accessed in the current
-* directory. If not, it searches for the command in the directories specified
-* by the PATH environment variable. If the command is found, its full path is
-* returned. If the command is not found or if there's an error in retrieving
-* the PATH environment variable, an appropriate error message is displayed, and
-* NULL is returned.
+* directory. If not, it asks the commands resolved so far, then the
+* resolution cache, then searches for the command in the PATH directories,
+* which are parsed into `data->paths` on the first miss and reused
+* afterwards. The result is remembered with `memo_store`, so a command is
+* looked up once however many stages or --batch pipelines run it.
 *
 * @param[in] cmd The command to find the path for.
 * @param[in] data Pointer to a t_data structure containing environment paths.
 * @return The full path of the command or NULL if not found.
 */
-char	*get_cmd(char*cmd, t_data*data)
+char	*resolve_cmd(char*cmd, t_data*data)
 {
-	char	**env_paths;
 	char	*cmd_path;
+	int		hit;
 
 	if (access(cmd, F_OK | X_OK) == 0)
 		return (ft_strdup(cmd));
-	env_paths = get_env_paths(data->envp);
-	if (!env_paths)
-		return (NULL);
-	cmd_path = get_cmd_path(cmd, env_paths);
+	if (memo_lookup(data, cmd, &cmd_path))
+		return (cmd_path);
+	cmd_path = cache_lookup(data, cmd, &hit);
+	if (!hit)
+	{
+		if (!data->paths)
+			data->paths = get_env_paths(data->envp);
+		if (!data->paths)
+			return (NULL);
+		cmd_path = get_cmd_path(cmd, data);
+		cache_store(data, cmd, cmd_path);
+	}
+	memo_store(data, cmd, cmd_path);
+	return (cmd_path);
+}
+
+/**
+* Retrieves the full path of a command executable.
+*
+* Resolves the command with `resolve_cmd`. If the command is not found or if
+* there's an error in retrieving the PATH environment variable, an
+* appropriate error message is displayed, and NULL is returned.
+*
+* @param[in] cmd The command to find the path for.
+* @param[in] data Pointer to a t_data structure containing environment paths.
+* @return The full path of the command or NULL if not found.
+*/
+char	*get_cmd(char*cmd, t_data*data)
+{
+	char	*cmd_path;
+
+	cmd_path = resolve_cmd(cmd, data);
 	if (!cmd_path)
 		ft_printf("pipex: %s%s\n", cmd, ": command not found");
-	free_array(env_paths);
 	return (cmd_path);
 }
@@ -0,0 +1,177 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   path_index.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 12:48:20 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 12:48:20 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Doubles the capacity of a directory listing buffer.
+ *
+ * @param[in] buf The buffer, freed by this call.
+ * @param[in] len Number of bytes in use.
+ * @param[in,out] cap Capacity of the buffer, doubled.
+ * @return The new buffer, or NULL if the allocation failed.
+ */
+static char	*grow_buf(char *buf, size_t len, size_t *cap)
+{
+	char	*new;
+
+	*cap *= 2;
+	new = malloc(*cap);
+	if (new)
+		ft_memcpy(new, buf, len);
+	free(buf);
+	return (new);
+}
+
+/**
+ * Reads every record of a directory with getdents64.
+ *
+ * The listing is read in DIRENT_BUF_SIZE chunks into one buffer, which grows
+ * as needed. The buffer is kept for the lifetime of the index because the
+ * hash set points into it.
+ *
+ * @param[in] fd Descriptor of the open directory.
+ * @param[out] len Number of bytes of records read.
+ * @return The buffer holding the records, or NULL on error.
+ */
+static char	*list_dir(int fd, size_t *len)
+{
+	char	*buf;
+	size_t	cap;
+	long	n;
+
+	cap = DIRENT_BUF_SIZE;
+	buf = malloc(cap);
+	*len = 0;
+	n = 1;
+	while (buf && n > 0)
+	{
+		if (cap - *len < DIRENT_BUF_SIZE)
+			buf = grow_buf(buf, *len, &cap);
+		if (buf)
+			n = syscall(SYS_getdents64, fd, buf + *len, cap - *len);
+		if (buf && n > 0)
+			*len += n;
+	}
+	if (n >= 0)
+		return (buf);
+	free(buf);
+	return (NULL);
+}
+
+/**
+ * Adds the names of one PATH directory to the index.
+ *
+ * The directory stays open so that a lookup can confirm the executable with
+ * a single `faccessat` relative to it. Subdirectories and the "." and ".."
+ * entries are skipped, other entries are confirmed at lookup time.
+ *
+ * @param[in,out] index The index being built.
+ * @param[in] i Index of the directory in PATH.
+ * @param[in] path The directory, as stored in `data->paths`.
+ * @return 0 on success, 1 if the directory could not be listed.
+ */
+static int	index_dir(t_index *index, int i, char *path)
+{
+	t_dirent64	*ent;
+	size_t		len;
+	size_t		pos;
+
+	index->fds[i] = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (index->fds[i] == -1)
+		return (1);
+	index->bufs[i] = list_dir(index->fds[i], &len);
+	if (!index->bufs[i])
+		return (1);
+	pos = 0;
+	while (pos < len)
+	{
+		ent = (t_dirent64 *)(index->bufs[i] + pos);
+		if (ent->d_type != DT_DIR && ft_strncmp(ent->d_name, ".", 2)
+			&& ft_strncmp(ent->d_name, "..", 3)
+			&& index_insert(index, ent->d_name, i))
+			return (1);
+		pos += ent->d_reclen;
+	}
+	return (0);
+}
+
+/**
+ * Builds the index of every PATH directory.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the parsed PATH.
+ * @return 0 if the index can be used, 1 if it could not be allocated.
+ */
+static int	path_index_build(t_data *data)
+{
+	t_index	*index;
+	int		i;
+
+	index = &data->index;
+	index->bufs = ft_calloc(index->dirs + 1, sizeof(*index->bufs));
+	index->fds = malloc(sizeof(*index->fds) * (index->dirs + 1));
+	if (!index->bufs || !index->fds)
+		return (1);
+	i = 0;
+	while (i < index->dirs)
+		index->fds[i++] = -1;
+	i = 0;
+	while (i < index->dirs)
+	{
+		if (index_dir(index, i, data->paths[i]))
+			index->partial = 1;
+		i++;
+	}
+	return (index->size == 0);
+}
+
+/**
+ * Resolves a command through the PATH index.
+ *
+ * The index is only built when probing every directory for every command
+ * could cost at least PATH_INDEX_PROBES `access` calls. Each directory is then
+ * listed once, and a command is resolved with one hash lookup plus one
+ * `faccessat` confirming that the file is executable. When the index cannot
+ * answer, because it was not built, the name is not executable in its first
+ * directory, or a directory could not be listed, the caller falls back to
+ * probing each directory.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding PATH and index.
+ * @param[in] cmd The command name.
+ * @param[out] cmd_path The resolved path, or NULL if the command is not found.
+ * @return 1 if the index answered, 0 if the caller must probe PATH itself.
+ */
+int	path_index_find(t_data *data, char *cmd, char **cmd_path)
+{
+	t_index	*index;
+	t_slot	*slot;
+
+	index = &data->index;
+	*cmd_path = NULL;
+	if (!index->dirs)
+	{
+		while (data->paths[index->dirs])
+			index->dirs++;
+		if ((long)data->cmd_count * index->dirs < PATH_INDEX_PROBES
+			|| path_index_build(data))
+			index->partial = 1;
+	}
+	if (!index->size || ft_strchr(cmd, '/'))
+		return (0);
+	slot = index_lookup(index, cmd);
+	if (!slot)
+		return (!index->partial);
+	if (faccessat(index->fds[slot->dir], cmd, X_OK, 0) != 0)
+		return (0);
+	*cmd_path = ft_strjoin(data->paths[slot->dir], cmd);
+	return (*cmd_path != NULL);
+}
@@ -0,0 +1,142 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   path_index_set.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 12:31:55 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 12:31:55 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Finds the slot holding a name, or the empty slot where it belongs.
+ *
+ * Names are hashed with FNV-1a and collisions are resolved by linear probing.
+ *
+ * @param[in] slots The table to search.
+ * @param[in] size Number of slots, a power of two.
+ * @param[in] name The name to look for.
+ * @return Pointer to the matching or first empty slot.
+ */
+static t_slot	*probe(t_slot *slots, size_t size, char *name)
+{
+	unsigned long	hash;
+	size_t			i;
+	char			*c;
+
+	hash = 14695981039346656037UL;
+	c = name;
+	while (*c)
+		hash = (hash ^ (unsigned char)*c++) * 1099511628211UL;
+	i = hash & (size - 1);
+	while (slots[i].name && ft_strncmp(slots[i].name, name, -1))
+		i = (i + 1) & (size - 1);
+	return (&slots[i]);
+}
+
+/**
+ * Doubles the number of slots and rehashes every stored name.
+ *
+ * @param[in,out] index The set to grow.
+ * @return 0 on success, 1 if the allocation failed.
+ */
+static int	grow(t_index *index)
+{
+	t_slot	*slots;
+	size_t	size;
+	size_t	i;
+
+	size = 1024;
+	if (index->size)
+		size = index->size * 2;
+	slots = ft_calloc(size, sizeof(*slots));
+	if (!slots)
+		return (1);
+	i = 0;
+	while (i < index->size)
+	{
+		if (index->slots[i].name)
+			*probe(slots, size, index->slots[i].name) = index->slots[i];
+		i++;
+	}
+	free(index->slots);
+	index->slots = slots;
+	index->size = size;
+	return (0);
+}
+
+/**
+ * Adds a name to the set, unless an earlier directory already holds it.
+ *
+ * Directories are inserted in PATH order, so keeping the first occurrence
+ * gives the same precedence as probing the directories one by one.
+ *
+ * @param[in,out] index The set to update.
+ * @param[in] name The file name, which must outlive the set.
+ * @param[in] dir Index of the PATH directory holding the name.
+ * @return 0 on success, 1 if the set could not grow.
+ */
+int	index_insert(t_index *index, char *name, int dir)
+{
+	t_slot	*slot;
+
+	if (index->count * 2 >= index->size && grow(index))
+		return (1);
+	slot = probe(index->slots, index->size, name);
+	if (slot->name)
+		return (0);
+	slot->name = name;
+	slot->dir = dir;
+	index->count++;
+	return (0);
+}
+
+/**
+ * Looks a name up in the set.
+ *
+ * @param[in] index The set to search.
+ * @param[in] name The name to look for.
+ * @return The slot of the name, or NULL if no PATH directory holds it.
+ */
+t_slot	*index_lookup(t_index *index, char *name)
+{
+	t_slot	*slot;
+
+	if (!index->size)
+		return (NULL);
+	slot = probe(index->slots, index->size, name);
+	if (!slot->name)
+		return (NULL);
+	return (slot);
+}
+
+/**
+ * Releases the PATH index.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the index.
+ */
+void	path_index_free(t_data *data)
+{
+	t_index	*index;
+	int		i;
+
+	index = &data->index;
+	i = 0;
+	while (index->bufs && i < index->dirs)
+		free(index->bufs[i++]);
+	i = 0;
+	while (index->fds && i < index->dirs)
+	{
+		if (index->fds[i] != -1)
+			close(index->fds[i]);
+		i++;
+	}
+	free(index->bufs);
+	free(index->fds);
+	free(index->slots);
+	ft_bzero(index, sizeof(*index));
+}
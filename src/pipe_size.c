@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipe_size.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:05:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 11:05:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Returns the largest capacity an unprivileged process may give a pipe.
+ *
+ * Read once from /proc/sys/fs/pipe-max-size. When the file cannot be read the
+ * kernel default of 1 MiB is assumed.
+ *
+ * @return The maximum pipe capacity in bytes.
+ */
+static int	pipe_max_size(void)
+{
+	static int	max_size;
+	char		buf[32];
+	ssize_t		n;
+	int			fd;
+
+	if (max_size > 0)
+		return (max_size);
+	max_size = 1048576;
+	fd = open("/proc/sys/fs/pipe-max-size", O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return (max_size);
+	n = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (n <= 0)
+		return (max_size);
+	buf[n] = '\0';
+	if (ft_atoi(buf) > 0)
+		max_size = ft_atoi(buf);
+	return (max_size);
+}
+
+/**
+ * Derives a pipe capacity from the size of the input file.
+ *
+ * A pipe holding the whole input, up to PIPE_AUTO_MAX, lets a fast writer
+ * run ahead without blocking every 64 KiB. Inputs that fit in the default
+ * capacity, and inputs that are not regular files, keep the default.
+ *
+ * @param[in] data Pointer to the t_data structure holding the input file.
+ * @return The capacity in bytes, or 0 to keep the default.
+ */
+static int	auto_pipe_size(t_data *data)
+{
+	struct stat	st;
+
+	if (data->input_fd < 0 || fstat(data->input_fd, &st) == -1)
+		return (0);
+	if (!S_ISREG(st.st_mode) || st.st_size <= PIPE_DEFAULT_SIZE)
+		return (0);
+	if (st.st_size > PIPE_AUTO_MAX)
+		return (PIPE_AUTO_MAX);
+	return (st.st_size);
+}
+
+/**
+ * Looks up the capacity requested for a pipe.
+ *
+ * A size given for this pipe wins over a size given for every pipe, and
+ * among sizes of the same kind the last one given wins.
+ *
+ * @param[in] data Pointer to the t_data structure holding the options.
+ * @param[in] edge Number of the pipe, counting from 1.
+ * @return The capacity in bytes, PIPE_SIZE_AUTO, or 0 if none was requested.
+ */
+static int	wanted_pipe_size(t_data *data, int edge)
+{
+	t_list		*node;
+	t_pipe_size	*pipe_size;
+	int			all;
+	int			own;
+
+	all = 0;
+	own = 0;
+	node = data->opts.pipe_sizes;
+	while (node)
+	{
+		pipe_size = node->content;
+		if (pipe_size->edge == edge)
+			own = pipe_size->size;
+		else if (pipe_size->edge == 0)
+			all = pipe_size->size;
+		node = node->next;
+	}
+	if (own)
+		return (own);
+	return (all);
+}
+
+/**
+ * Applies the capacity requested with --pipe-size to a new pipe.
+ *
+ * The size is clamped to /proc/sys/fs/pipe-max-size and set with
+ * F_SETPIPE_SZ, which rounds it up to a power of two pages. The capacity is
+ * only a hint, a pipe the kernel refuses to resize, for instance because the
+ * user reached its pipe buffer limit, keeps the default.
+ *
+ * @param[in] data Pointer to the t_data structure holding the options.
+ * @param[in] edge Number of the pipe, counting from 1.
+ * @param[in] fds The two descriptors of the pipe.
+ */
+void	apply_pipe_size(t_data *data, int edge, int *fds)
+{
+	int	size;
+
+	size = wanted_pipe_size(data, edge);
+	if (size == PIPE_SIZE_AUTO)
+		size = auto_pipe_size(data);
+	if (size <= 0)
+		return ;
+	if (size > pipe_max_size())
+		size = pipe_max_size();
+	fcntl(fds[1], F_SETPIPE_SZ, size);
+}
@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipestatus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:02:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:38:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Converts the wait status of a stage into the exit code a shell reports for
+ * it.
+ *
+ * @param[in] stage The stage.
+ * @return The exit code of the stage, 128 plus the signal number for a stage
+ *         killed by a signal, TIMEOUT_STATUS for a stage stopped at its
+ *         deadline, or -1 if the status is unknown.
+ */
+int	stage_exit_code(t_stage *stage)
+{
+	int	status;
+
+	status = stage->status;
+	if (stage->timed_out)
+		return (TIMEOUT_STATUS);
+	if (status == -1)
+		return (-1);
+	if (WIFEXITED(status))
+		return (WEXITSTATUS(status));
+	if (WIFSIGNALED(status))
+		return (128 + WTERMSIG(status));
+	return (-1);
+}
+
+/**
+ * Computes the exit code of pipex from the wait status of the stages.
+ *
+ * This is the exit code of the last stage, or 1 if it did not exit normally,
+ * like before stages were reaped in the order they exit. When a stage was
+ * stopped at its deadline the exit code is TIMEOUT_STATUS instead, so that a
+ * timed out pipeline can be told apart from one that failed on its own.
+ * When the last stage succeeded but a --tee branch, an --input pipeline or
+ * the here_doc feeder failed, the exit code is the one of that helper, see
+ * `record_helper`.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ * @return The exit code of pipex.
+ */
+int	pipeline_exit_code(t_data *data)
+{
+	int	status;
+	int	i;
+
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		if (data->stages[i++].timed_out)
+			return (TIMEOUT_STATUS);
+	}
+	status = data->stages[data->cmd_count - 1].status;
+	if (status == -1 || !WIFEXITED(status))
+		return (1);
+	if (WEXITSTATUS(status) == 0 && data->helper_status)
+		return (data->helper_status);
+	return (WEXITSTATUS(status));
+}
+
+/**
+ * Records the wait status of a helper running part of the pipeline, such as
+ * a --tee branch, so that its failure is not lost.
+ *
+ * Only the first failure is kept, as the exit code of the helper, or 128
+ * plus the signal that killed it.
+ *
+ * @param[in,out] data Pointer to the t_data structure receiving the exit
+ *                     code in `helper_status`.
+ * @param[in] status Wait status of the helper.
+ */
+void	record_helper(t_data *data, int status)
+{
+	if (data->helper_status)
+		return ;
+	if (WIFEXITED(status))
+		data->helper_status = WEXITSTATUS(status);
+	else if (WIFSIGNALED(status))
+		data->helper_status = 128 + WTERMSIG(status);
+}
+
+/**
+ * Prints the exit code of every stage to STDERR, like the PIPESTATUS array of
+ * bash, as in "PIPESTATUS: 0 1 141".
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ */
+void	print_pipestatus(t_data *data)
+{
+	t_strbuf	sb;
+	int			i;
+
+	ft_bzero(&sb, sizeof(sb));
+	sb_add(&sb, "PIPESTATUS:");
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		sb_add(&sb, " ");
+		sb_add_num(&sb, stage_exit_code(&data->stages[i++]));
+	}
+	sb_add(&sb, "\n");
+	sb_flush(&sb, STDERR_FILENO);
+}
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipestatus_json.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:50:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 14:40:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Appends a number, or null when it does not apply.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] valid Non-zero if the number applies.
+ * @param[in] num The number to append.
+ */
+static void	add_num_or_null(t_strbuf *sb, int valid, long num)
+{
+	if (valid)
+		sb_add_num(sb, num);
+	else
+		sb_add(sb, "null");
+}
+
+/**
+ * Appends an argument vector as a JSON array of strings.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] argv The arguments, or NULL for an empty array.
+ */
+void	add_argv_json(t_strbuf *sb, char **argv)
+{
+	int	j;
+
+	sb_add(sb, "[");
+	j = 0;
+	while (argv && argv[j])
+	{
+		if (j > 0)
+			sb_add(sb, ", ");
+		sb_add_json(sb, argv[j++]);
+	}
+	sb_add(sb, "]");
+}
+
+/**
+ * Appends the JSON object describing one stage.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage.
+ */
+static void	add_stage_json(t_strbuf *sb, t_data *data, int i)
+{
+	t_stage	*stage;
+
+	stage = &data->stages[i];
+	sb_add(sb, "{\"stage\": ");
+	sb_add_num(sb, i + 1);
+	sb_add(sb, ", \"argv\": ");
+	add_argv_json(sb, stage->argv);
+	sb_add(sb, ", \"pid\": ");
+	sb_add_num(sb, data->pids[i]);
+	sb_add(sb, ", \"exit\": ");
+	add_num_or_null(sb, stage->status != -1 && WIFEXITED(stage->status),
+		WEXITSTATUS(stage->status));
+	sb_add(sb, ", \"signal\": ");
+	add_num_or_null(sb, stage->status != -1 && WIFSIGNALED(stage->status),
+		WTERMSIG(stage->status));
+	if (stage->timed_out)
+		sb_add(sb, ", \"timed_out\": true}");
+	else
+		sb_add(sb, ", \"timed_out\": false}");
+}
+
+/**
+ * Writes a report to a file and releases it.
+ *
+ * A file that cannot be written is reported on STDERR but does not change the
+ * exit code of pipex.
+ *
+ * @param[in,out] sb The report, empty afterwards.
+ * @param[in] path Path of the file, created or truncated.
+ */
+void	write_report(t_strbuf *sb, char *path)
+{
+	int	fd;
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd == -1 || sb_flush(sb, fd))
+		ft_printf("pipex: %s: %s\n", path, strerror(errno));
+	free(sb->str);
+	ft_bzero(sb, sizeof(*sb));
+	if (fd != -1)
+		close(fd);
+}
+
+/**
+ * Writes the exit status of every stage to the file given with
+ * --pipestatus-json.
+ *
+ * The file holds one object with the exit code of pipex and a "stages" array,
+ * one object per stage with its arguments, process ID, exit code, the
+ * signal that killed it, null when not applicable, and whether it was
+ * stopped at its deadline.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ * @param[in] exit_code The exit code of pipex.
+ */
+void	write_pipestatus_json(t_data *data, int exit_code)
+{
+	t_strbuf	sb;
+	int			i;
+
+	ft_bzero(&sb, sizeof(sb));
+	sb_add(&sb, "{\"exit_code\": ");
+	sb_add_num(&sb, exit_code);
+	sb_add(&sb, ", \"stages\": [");
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		if (i > 0)
+			sb_add(&sb, ", ");
+		add_stage_json(&sb, data, i++);
+	}
+	sb_add(&sb, "]}\n");
+	write_report(&sb, data->opts.pipestatus_json);
+}
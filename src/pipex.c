@@ -6,98 +6,27 @@
 /*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/22 00:39:14 by fde-alen          #+#    #+#             */
-/*   Updated: 2024/01/22 04:57:13 by fde-alen         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:50:00 by fde-alen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "pipex.h"
 
-/**
- * Redirects the standard input and output of a process.
- *
- * This function is responsible for redirecting the standard input (STDIN) and
- * standard output (STDOUT) of a process to specified file descriptors. It uses
- * the `dup2` system call to duplicate the given file descriptors to
- * STDIN_FILENO and STDOUT_FILENO. If either of the input or output file
- * descriptors is invalid (less than 0), the function will call
- * `cleanup_n_exit` to handle the situation. Similarly, if an error occurs
- * during the redirection process (e.g., `dup2` fails), the function will call
- * `exit_error` with an appropriate error message or code.
- *
- * @param[in] input The file descriptor to be set as the new standard input
- *                  (STDIN_FILENO).
- * @param[in] output The file descriptor to be set as the new standard output
- *                   (STDOUT_FILENO).
- * @param[in,out] data Pointer to a t_data structure for error handling and
- *                     other purposes.
- */
-static void	redirect_io(int input, int output, t_data *data)
-{
-	if (input < 0 || output < 0)
-		cleanup_n_exit(ERROR, data);
-	if (dup2(input, STDIN_FILENO) == -1)
-		cleanup_n_exit(ERROR, data);
-	if (dup2(output, STDOUT_FILENO) == -1)
-		cleanup_n_exit(ERROR, data);
-}
-
-/**
- * Executes a child process in the Pipex pipeline.
- *
- * This function is responsible for configuring and executing a single command
- * within the pipeline. It redirects the standard input and output for the
- * child process based on its position in the pipeline:
- * - The first child uses the initial input file descriptor and the write-end
- *   of the first pipe.
- * - The last child uses the read-end of the last pipe and the final output
- *   file descriptor.
- * - Middle children use the read-end of their respective input pipe and the
- *   write-end of their respective output pipe. After setting up the
- *   redirection, the function closes any file descriptors that are no longer
- *   needed. It validates the command and its options and then executes the
- *   command using `execve`. If `execve` fails, it handles the error
- *   appropriately.
- *
- * @param[in,out] data Pointer to the `t_data` structure containing necessary
- *                     information for the child process, including file
- *                     descriptors, command options, and environment variables.
- */
-static void	execute_child_process(t_data *data)
-{
-	if (data->child == 0)
-	{
-		redirect_io(data->input_fd, data->pipe[1], data);
-	}
-	else if (data->child == data->cmd_count - 1)
-	{
-		redirect_io(data->pipe[2 * data->child - 2], data->output_fd, data);
-	}
-	else
-	{
-		redirect_io(data->pipe[2 * data->child - 2],
-			data->pipe[2 * data->child + 1], data);
-	}
-	close_fds(data);
-	if (data->cmd_options == NULL || data->cmd_path == NULL)
-	{
-		cleanup_n_exit(ERROR, data);
-	}
-	if (execve(data->cmd_path, data->cmd_options, data->envp) == -1)
-	{
-		cleanup_n_exit(ERROR, data);
-		ft_printf("pipex: %s: %s\n", data->cmd_options[0], strerror(errno));
-	}
-}
-
 /**
  * Manages the parent process in a pipeline of command executions.
  *
  * This function is responsible for closing unnecessary file descriptors and
- * waiting for child processes to complete their execution. It iterates through
- * the child processes, using `waitpid` to wait for each child to finish. The
- * function captures the exit status of the last child process in the pipeline,
- * which it returns as the overall exit code. It also performs cleanup by
- * freeing memory allocated for pipes and process IDs.
+ * waiting for child processes to complete their execution. The stages are
+ * reaped in the order they exit by `reap_stages`, which records the wait
+ * status of every one of them. The exit status of the last stage in the
+ * pipeline is returned as the overall exit code, as before, unless a stage
+ * was stopped at its deadline, see `pipeline_exit_code`. With
+ * --pipestatus and --pipestatus-json the status of every stage is reported
+ * as well, with --stats the resources each one used and with --meter the
+ * traffic of the metered pipes, once their relays exited. The --tee branches
+ * and the --input merge are waited for too, so that their outfiles are
+ * complete and no child is left behind. It also performs
+ * cleanup by freeing memory allocated for pipes and process IDs.
  *
  * @param[in,out] data Pointer to a t_data structure containing necessary
  *                     information, such as the number of commands, child
@@ -108,23 +37,26 @@ static void	execute_child_process(t_data *data)
  */
 static int	execute_parent_process(t_data *data)
 {
-	pid_t	wpid;
-	int		status;
 	int		exit_code;
 
 	close_fds(data);
-	data->child--;
-	exit_code = 1;
-	while (data->child >= 0)
-	{
-		wpid = waitpid(data->pids[data->child], &status, 0);
-		if (wpid == data->pids[data->cmd_count - 1])
-		{
-			if ((data->child == (data->cmd_count - 1)) && WIFEXITED(status))
-				exit_code = WEXITSTATUS(status);
-		}
-		data->child--;
-	}
+	reap_stages(data);
+	wait_meters(data);
+	wait_tees(data);
+	wait_merge(data);
+	wait_feeder(data);
+	free_zygotes(data);
+	exit_code = pipeline_exit_code(data);
+	if (data->opts.pipestatus)
+		print_pipestatus(data);
+	if (data->opts.pipestatus_json)
+		write_pipestatus_json(data, exit_code);
+	if (data->opts.stats)
+		print_stats(data);
+	if (data->opts.stats_file)
+		write_stats_json(data);
+	print_meters(data);
+	free_meters(data);
 	free(data->pipe);
 	free(data->pids);
 	return (exit_code);
@@ -133,45 +65,45 @@ static int	execute_parent_process(t_data *data)
 /**
  * Manages the execution of a pipeline of commands.
  *
- * This function sets up a pipe and forks child processes for each command in the
- * pipeline. Each child process is responsible for executing one command. The
- * parent process waits for all child processes to complete and then collects
- * their exit codes. It handles the creation of pipes, parsing and execution of
- * commands, and manages potential errors in these processes. If a heredoc is
- * used, the function also ensures the removal of the temporary file after
- * execution.
+ * This function first forks the helpers requested with --zygotes, while
+ * pipex is still small, then resolves every command of the pipeline with
+ * `plan_stages`, so that PATH is parsed once and no lookup happens between
+ * two launches, and simplifies the plan with `rewrite_stages` when
+ * --rewrite was given, rejects per-stage options naming a stage past its
+ * end with `check_plan`, then gives the stages of the final plan the
+ * workers requested with --parallel, the CPUs of --cpu-placement and
+ * --cpus and the priorities of --nice, --sched and --ioprio. It then sets up
+ * the pipes and starts a child process for each command back to back with
+ * `launch_stages`. Each child process is responsible for executing one
+ * command. The parent process waits for all child processes to complete and
+ * then collects their exit codes. It handles the creation of pipes, parsing
+ * and execution of commands, and manages potential errors in these
+ * processes.
  *
  * @param[in,out] data Pointer to a t_data structure containing necessary
  *                     information for pipelined command execution.
  *
  * @return The exit code of the last child process in the pipeline.
  */
-static int	pipex(t_data *d)
+int	pipex(t_data *d)
 {
 	int	exit_code;
 
-	if (pipe(d->pipe) == -1)
-		cleanup_n_exit(ft_printf(" pipe: %s\n", strerror(errno)), d);
-	d->child = 0;
-	while (d->child < d->cmd_count)
-	{
-		d->cmd_options = ft_split(d->av[d->child + 2 + d->heredoc_flag], ' ');
-		if (!d->cmd_options)
-			cleanup_n_exit(ft_printf("cmd_opt error:%s\n", strerror(errno)), d);
-		d->cmd_path = get_cmd(d->cmd_options[0], d);
-		d->pids[d->child] = fork();
-		if (d->pids[d->child] == -1)
-			cleanup_n_exit(ft_printf("fork error: %s\n", strerror(errno)), d);
-		else if (d->pids[d->child] == 0)
-			execute_child_process(d);
-		free(d->cmd_path);
-		d->cmd_path = NULL;
-		free_array(d->cmd_options);
-		d->child++;
-	}
+	start_zygotes(d);
+	plan_stages(d);
+	if (d->opts.rewrite)
+		rewrite_stages(d);
+	check_plan(d);
+	plan_workers(d);
+	plan_placement(d);
+	plan_priorities(d);
+	if (d->opts.print_plan)
+		print_plan(d);
+	setup_pipes(d);
+	launch_stages(d);
 	exit_code = execute_parent_process(d);
-	if (d->heredoc_flag == 1)
-		unlink(".heredoc.tmp");
+	free_stages(d);
+	free_options(&d->opts);
 	return (exit_code);
 }
 
@@ -179,12 +111,16 @@ static int	pipex(t_data *d)
  * Entry point for the Pipex program.
  *
  * This function is responsible for initializing and executing the Pipex pipeline
- * process. It starts by validating the command-line arguments to ensure they
+ * process. It starts by parsing the leading options, and with --batch runs
+ * the pipelines of the manifest instead, see `run_batch`, or with --serve
+ * serves pipelines on a socket, see `run_serve`. It then validates
+ * the remaining command-line arguments to ensure they
  * meet the program's requirements. If the arguments are insufficient or
  * incorrect, it displays usage instructions. It checks for a valid environment
  * before initializing the pipeline process with provided arguments. Once
  * initialized, it invokes the pipex function to manage the execution of commands
- * within a pipeline. Finally, it returns the exit code from the last command
+ * within a pipeline, or with --submit hands the pipeline to a server, see
+ * `submit_job`. Finally, it returns the exit code from the last command
  * executed by Pipex.
  *
  * @param argc The count of command-line arguments.
@@ -197,12 +133,25 @@ static int	pipex(t_data *d)
 int	main(int argc, char **argv, char **envp)
 {
 	t_data	data;
+	t_opts	opts;
 	int		exit_code;
+	int		skip;
 
 	exit_code = -1;
-	if (invalid_args(argc, argv, envp))
+	skip = parse_options(argc, argv, &opts);
+	if (skip >= 0 && opts.batch)
+		return (run_batch(&opts, argc - skip - 1, envp));
+	if (skip >= 0 && opts.serve)
+		return (run_serve(&opts, argc - skip - 1, envp));
+	if (skip < 0 || invalid_args(argc - skip, argv + skip, envp)
+		|| check_submit(&opts))
+	{
+		free_options(&opts);
 		return (1);
-	data = init_data(argc, argv, envp);
+	}
+	if (opts.submit)
+		return (submit_job(&opts, argc - skip, argv + skip));
+	data = init_data(argc - skip, argv + skip, envp, &opts);
 	exit_code = pipex(&data);
 	return (exit_code);
 }
@@ -6,7 +6,7 @@
 /*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/22 00:38:58 by fde-alen          #+#    #+#             */
-/*   Updated: 2024/01/22 00:39:01 by fde-alen         ###   ########.fr       */
+/*   Updated: 2026/10/16 22:06:30 by fde-alen         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,6 +19,7 @@
  * `pipe` field of the `t_data` structure and closes each one. The number of
  * file descriptors to close is determined by the number of commands minus one,
  * multiplied by two (since each pipe consists of two file descriptors).
+ * Nothing is closed if the pipes were not set up yet.
  *
  * @param[in,out] data Pointer to a t_data structure containing the pipe file
  * descriptors and the number of commands.
@@ -27,6 +28,8 @@ static void	close_pipe_fds(t_data *data)
 {
 	int	i;
 
+	if (!data->pipe)
+		return ;
 	i = 0;
 	while (i < (data->cmd_count - 1) * 2)
 	{
@@ -40,8 +43,9 @@ static void	close_pipe_fds(t_data *data)
  *
  * This function is responsible for closing the input and output file
  * descriptors, as well as all pipe file descriptors associated with the pipex
- * process. It checks if the input and output file descriptors are valid (not
- * equal to -1) before attempting to close them. The function then calls
+ * process, including the pipes held with --jit-pipes. It checks if the input
+ * and output file descriptors are valid (not equal to -1) before attempting
+ * to close them. The function then calls
  * `close_pipe_fds` to close all pipe file descriptors.
  *
  * @param[in,out] data Pointer to a t_data structure that contains the file
@@ -53,6 +57,12 @@ void	close_fds(t_data *data)
 		close(data->input_fd);
 	if (data->output_fd != -1)
 		close(data->output_fd);
+	if (data->prev_read != -1)
+		close(data->prev_read);
+	if (data->next_pipe[0] != -1)
+		close(data->next_pipe[0]);
+	if (data->next_pipe[1] != -1)
+		close(data->next_pipe[1]);
 	close_pipe_fds(data);
 }
 
@@ -62,10 +72,9 @@ void	close_fds(t_data *data)
  *
  * This function is called when an error is encountered. It ensures that all
  * allocated resources and open file descriptors are properly freed and closed
- * to prevent memory leaks and other resource-related issues. Additionally, if a
- * heredoc was used in the program, it removes the temporary file associated with
- * it. After handling these cleanup tasks, the function terminates the program
- * and returns the specified error status code.
+ * to prevent memory leaks and other resource-related issues. After handling
+ * these cleanup tasks, the function terminates the program and returns the
+ * specified error status code.
  *
  * @param[in] error_status The exit status code to be returned upon program
  *                        termination.
@@ -82,16 +91,11 @@ void	cleanup_n_exit(int error_status, t_data *data)
 			free(data->pipe);
 		if (data->pids)
 			free(data->pids);
-		if (data->cmd_options)
-			free_array(data->cmd_options);
-		if (data->cmd_path)
-		{
-			free(data->cmd_path);
-			data->cmd_path = NULL;
-		}
+		free_stages(data);
+		free_options(&data->opts);
+		free_meters(data);
+		free(data->zygotes);
 	}
-	if (data->heredoc_flag == 1)
-		unlink(".heredoc.tmp");
 	exit(error_status);
 }
 
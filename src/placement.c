@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   placement.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 21:04:40 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 21:04:40 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Pins a stage to a single CPU.
+ *
+ * @param[out] stage The stage.
+ * @param[in] cpu The CPU.
+ */
+static void	pin_stage(t_stage *stage, int cpu)
+{
+	CPU_ZERO(&stage->cpus);
+	CPU_SET(cpu, &stage->cpus);
+	stage->pinned = 1;
+}
+
+/**
+ * Pins every stage to a CPU following the policy of --cpu-placement.
+ *
+ * The CPUs pipex may run on are taken in the order of `cpu_order`. With
+ * "compact" stage i gets the i-th CPU, so adjacent stages share a core or
+ * a package. With "spread" the stages are spaced evenly over the list. When
+ * there are more stages than CPUs, stages wrap around the list. Stages run
+ * with --parallel are left unpinned so their workers may use every CPU.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ */
+static void	place_stages(t_data *data)
+{
+	int		*order;
+	int		count;
+	long	pos;
+	int		i;
+
+	order = cpu_order(&count);
+	i = 0;
+	while (order && count > 0 && i < data->cmd_count)
+	{
+		pos = i % count;
+		if (data->opts.placement == PLACE_SPREAD && data->cmd_count <= count)
+			pos = (long)i * count / data->cmd_count;
+		if (!data->stages[i].workers)
+			pin_stage(&data->stages[i], order[pos]);
+		i++;
+	}
+	free(order);
+}
+
+/**
+ * Decides the CPUs of the stages of the final plan, from --cpu-placement,
+ * then from --cpus, which wins for the stages it names.
+ *
+ * Pinned stages are always forked, so that `execute_child_process` applies
+ * their CPUs before exec, see `apply_placement`.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ */
+void	plan_placement(t_data *data)
+{
+	t_list			*node;
+	t_stage_cpus	*cpus;
+
+	if (data->opts.placement != PLACE_NONE)
+		place_stages(data);
+	node = data->opts.stage_cpus;
+	while (node)
+	{
+		cpus = node->content;
+		if (cpus->stage <= data->cmd_count)
+		{
+			data->stages[cpus->stage - 1].cpus = cpus->cpus;
+			data->stages[cpus->stage - 1].pinned = 1;
+		}
+		node = node->next;
+	}
+}
+
+/**
+ * Pins the calling process, the child of a stage, to the CPUs of the stage.
+ *
+ * A failure, as with CPUs outside of the cpuset of pipex, leaves the stage
+ * unpinned.
+ *
+ * @param[in] stage The stage.
+ */
+void	apply_placement(t_stage *stage)
+{
+	if (stage->pinned)
+		sched_setaffinity(0, sizeof(stage->cpus), &stage->cpus);
+}
@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   plan.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:02:44 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:58:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Splits one command into its arguments and resolves it.
+ *
+ * The resolved binary is opened with O_PATH right away, so the parent walks
+ * its path once and the child executes the very file that was resolved, see
+ * `exec_stage`. The descriptor is closed once the stage is launched. With
+ * --jit-pipes, which keeps the number of open descriptors constant, the
+ * binary is executed by path instead.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the command
+ *                     strings and the stages.
+ * @param[in] i Index of the command to plan.
+ */
+static void	plan_stage(t_data *data, int i)
+{
+	t_stage	*stage;
+
+	stage = &data->stages[i];
+	stage->exec_fd = -1;
+	stage->status = -1;
+	stage->pidfd = -1;
+	stage->remote = -1;
+	stage->argv = ft_split(data->cmds[i], ' ');
+	if (!stage->argv)
+		cleanup_n_exit(ft_printf("cmd_opt error:%s\n", strerror(errno)),
+			data);
+	if (data->opts.builtins && find_builtin(stage->argv))
+		stage->builtin = find_builtin(stage->argv)->run;
+	else if (stage->argv[0])
+		stage->path = get_cmd(stage->argv[0], data);
+	if (stage->path && !data->opts.jit_pipes)
+		stage->exec_fd = open(stage->path, O_PATH | O_CLOEXEC);
+	if (!stage->builtin && !stage->argv[0])
+		ft_printf("pipex: %s%s\n", data->cmds[i], ": command not found");
+}
+
+/**
+ * Resolves every command of the pipeline before the first stage starts.
+ *
+ * PATH is parsed at most once into `data->paths` and reused for every lookup.
+ * With --cache, the on-disk resolution cache is opened first so that cached
+ * commands skip PATH entirely. Each command string is split into its
+ * arguments. Commands handled by a builtin are not resolved at all, the others
+ * have their executable looked up with `get_cmd`. A command that cannot be
+ * found keeps a NULL path, and its stage fails when launched, like it did
+ * when commands were resolved one at a time. Doing all the lookups first means
+ * the stages are started back to back, without an earlier stage waiting on a
+ * downstream reader that is not running yet.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the command
+ *                     strings and receiving the resolved stages.
+ */
+void	plan_stages(t_data *data)
+{
+	int	i;
+
+	if (data->opts.cache)
+		cache_open(data);
+	data->stages = ft_calloc(data->cmd_count, sizeof(*data->stages));
+	if (!data->stages)
+		cleanup_n_exit(ft_printf("stage error: %s\n", strerror(errno)), data);
+	i = 0;
+	while (i < data->cmd_count)
+		plan_stage(data, i++);
+}
+
+/**
+ * Frees the resolved stages, the parsed PATH directories, their index, the
+ * commands resolved so far and the cache.
+ *
+ * Safe to call more than once and on a partially planned pipeline, since
+ * every freed pointer is reset to NULL.
+ *
+ * @param[in,out] data Pointer to a t_data structure holding the stages.
+ */
+void	free_stages(t_data *data)
+{
+	int	i;
+
+	i = 0;
+	while (data->stages && i < data->cmd_count)
+	{
+		free_array(data->stages[i].argv);
+		free(data->stages[i].path);
+		if (data->stages[i].exec_fd != -1)
+			close(data->stages[i].exec_fd);
+		if (data->stages[i].remote != -1)
+			close(data->stages[i].remote);
+		i++;
+	}
+	free(data->stages);
+	data->stages = NULL;
+	path_index_free(data);
+	free_array(data->paths);
+	data->paths = NULL;
+	memo_free(data);
+	cache_close(data);
+}
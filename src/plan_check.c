@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   plan_check.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:58:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:58:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Reads the stage or pipe number of one element of a per-stage option list.
+ *
+ * @param[in] content Element of the list.
+ * @param[in] type What the list holds, LIST_STAGE_VALUE, LIST_TEE,
+ *                 LIST_CPUS, LIST_PIPE_SIZE or LIST_EDGE.
+ * @return The number the element applies to.
+ */
+static int	list_number(void *content, int type)
+{
+	if (type == LIST_TEE)
+		return (((t_tee *)content)->stage);
+	if (type == LIST_CPUS)
+		return (((t_stage_cpus *)content)->stage);
+	if (type == LIST_PIPE_SIZE)
+		return (((t_pipe_size *)content)->edge);
+	if (type == LIST_EDGE)
+		return (*(int *)content);
+	return (((t_stage_value *)content)->stage);
+}
+
+/**
+ * Checks that every stage or pipe a per-stage option names exists.
+ *
+ * Lists of LIST_PIPE_SIZE and LIST_EDGE name pipes, the others name stages.
+ * 0 stands for every stage or pipe and is always valid.
+ *
+ * @param[in] d Pointer to a t_data structure holding the number of stages.
+ * @param[in] node First node of the list given with the option.
+ * @param[in] type What the list holds, see `list_number`.
+ * @param[in] option Name of the option, for the error message.
+ * @return 1 if a number is past the last stage or pipe, 0 otherwise.
+ */
+static int	check_numbers(t_data *d, t_list *node, int type, char *option)
+{
+	char	*what;
+	int		number;
+	int		last;
+	int		err;
+
+	what = "stage";
+	last = d->cmd_count;
+	if (type == LIST_PIPE_SIZE || type == LIST_EDGE)
+	{
+		what = "pipe";
+		last = d->cmd_count - 1;
+	}
+	err = 0;
+	while (node)
+	{
+		number = list_number(node->content, type);
+		if (number > last)
+		{
+			ft_printf("pipex: --%s: no %s %d, the last is %d\n", option,
+				what, number, last);
+			err = 1;
+		}
+		node = node->next;
+	}
+	return (err);
+}
+
+/**
+ * Rejects per-stage options naming a stage or a pipe past the end of the
+ * final plan, which would otherwise be silently ignored.
+ *
+ * Called once the plan is final, so the numbers are checked against the
+ * stages that are actually started.
+ *
+ * @param[in,out] d Pointer to a t_data structure holding the options and the
+ *                  number of stages.
+ */
+void	check_plan(t_data *d)
+{
+	int	err;
+
+	err = check_numbers(d, d->opts.stage_timeouts, LIST_STAGE_VALUE,
+			"stage-timeout");
+	err |= check_numbers(d, d->opts.parallel, LIST_STAGE_VALUE, "parallel");
+	err |= check_numbers(d, d->opts.tees, LIST_TEE, "tee");
+	err |= check_numbers(d, d->opts.stage_cpus, LIST_CPUS, "cpus");
+	err |= check_numbers(d, d->opts.stage_nice, LIST_STAGE_VALUE, "nice");
+	err |= check_numbers(d, d->opts.stage_sched, LIST_STAGE_VALUE, "sched");
+	err |= check_numbers(d, d->opts.stage_ioprio, LIST_STAGE_VALUE,
+			"ioprio");
+	err |= check_numbers(d, d->opts.pipe_sizes, LIST_PIPE_SIZE, "pipe-size");
+	err |= check_numbers(d, d->opts.meter_edges, LIST_EDGE, "meter");
+	if (err)
+		cleanup_n_exit(1, d);
+}
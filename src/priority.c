@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   priority.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 21:36:40 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:56:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Looks up the setting of a per-stage priority option for a stage.
+ *
+ * @param[in] list The option list, of t_stage_value.
+ * @param[in] stage Number of the stage, counting from 1.
+ * @return The setting given for the stage, else the one given for every
+ *         stage, else PRIO_KEEP.
+ */
+static int	stage_priority(t_list *list, int stage)
+{
+	t_stage_value	*prio;
+	int				all;
+	int				own;
+
+	all = PRIO_KEEP;
+	own = PRIO_KEEP;
+	while (list)
+	{
+		prio = list->content;
+		if (prio->stage == stage)
+			own = prio->value;
+		else if (prio->stage == 0)
+			all = prio->value;
+		list = list->next;
+	}
+	if (own != PRIO_KEEP)
+		return (own);
+	return (all);
+}
+
+/**
+ * Decides the nice value, scheduling policy and I/O priority of the stages
+ * of the final plan, from --nice, --sched and --ioprio.
+ *
+ * Stages with any of them set are always forked, so that
+ * `execute_child_process` applies them before exec, see `apply_priorities`.
+ * The workers of a stage run with --parallel inherit the settings of the
+ * stage.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ */
+void	plan_priorities(t_data *data)
+{
+	t_stage	*stage;
+	int		i;
+
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		stage = &data->stages[i];
+		stage->nice = stage_priority(data->opts.stage_nice, i + 1);
+		stage->sched = stage_priority(data->opts.stage_sched, i + 1);
+		stage->ioprio = stage_priority(data->opts.stage_ioprio, i + 1);
+		stage->tuned = stage->nice != PRIO_KEEP || stage->sched != PRIO_KEEP
+			|| stage->ioprio != PRIO_KEEP;
+		i++;
+	}
+}
+
+/**
+ * Applies the priorities of a stage to the calling process, the child of the
+ * stage.
+ *
+ * The policy is set first, as SCHED_BATCH and SCHED_IDLE keep the nice value
+ * set afterwards. A setting the process is not allowed to apply, as a nice
+ * value below the one of pipex without CAP_SYS_NICE, is reported with the
+ * option that asked for it and left as inherited, the stage still runs.
+ *
+ * @param[in] stage The stage.
+ */
+void	apply_priorities(t_stage *stage)
+{
+	struct sched_param	param;
+
+	if (!stage->tuned)
+		return ;
+	ft_bzero(&param, sizeof(param));
+	if (stage->sched != PRIO_KEEP
+		&& sched_setscheduler(0, stage->sched, &param) == -1)
+		ft_printf("pipex: --sched: %s\n", strerror(errno));
+	if (stage->nice != PRIO_KEEP
+		&& setpriority(PRIO_PROCESS, 0, stage->nice) == -1)
+		ft_printf("pipex: --nice: %s\n", strerror(errno));
+	if (stage->ioprio != PRIO_KEEP
+		&& syscall(SYS_ioprio_set, IOPRIO_WHO_PROC, 0, stage->ioprio) == -1)
+		ft_printf("pipex: --ioprio: %s\n", strerror(errno));
+}
@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   reaper.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:02:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:40:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Reaps every stage that already exited, without blocking.
+ *
+ * Only the stages not reaped yet are waited for, each by its process ID, so
+ * that helpers such as the --tee relays, the --input merge or the here_doc
+ * feeder are left for the functions that wait for them and collect their
+ * status.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ */
+void	reap_ready(t_data *data)
+{
+	struct rusage	usage;
+	int				status;
+	int				i;
+
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		if (data->stages[i].status == -1 && data->pids[i] > 0
+			&& wait4(data->pids[i], &status, WNOHANG, &usage) > 0)
+			stage_exited(&data->stages[i], status, &usage);
+		i++;
+	}
+}
+
+/**
+ * Counts the stages not reaped yet.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ * @return The number of stages still running.
+ */
+int	stages_left(t_data *data)
+{
+	int	left;
+	int	i;
+
+	left = 0;
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		if (data->stages[i].status == -1 && data->pids[i] > 0)
+			left++;
+		i++;
+	}
+	return (left);
+}
+
+/**
+ * Handles one event of the wait loop.
+ *
+ * The timer expired: stages past their deadline are signaled. SIGCHLD was
+ * received on the signalfd: every stage that exited is reaped. Otherwise the
+ * event carries the index of a stage whose process descriptor is readable.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] reaper The descriptors of the wait loop.
+ * @param[in] tag The tag of the event.
+ */
+static void	handle_event(t_data *data, t_reaper *reaper, unsigned int tag)
+{
+	struct signalfd_siginfo	info;
+	uint64_t				expirations;
+
+	if (tag == REAP_TIMER)
+	{
+		read(reaper->tfd, &expirations, sizeof(expirations));
+		expire_stages(data);
+	}
+	else if (tag == REAP_SIGNAL)
+	{
+		read(reaper->sfd, &info, sizeof(info));
+		reap_ready(data);
+	}
+	else
+		reap_stage(data, tag);
+}
+
+/**
+ * Waits for the next events of the wait loop and handles them.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] reaper The descriptors of the wait loop.
+ * @return 0 on success, -1 if the loop cannot go on.
+ */
+static int	reaper_wait(t_data *data, t_reaper *reaper)
+{
+	struct epoll_event	ev[REAP_EVENTS];
+	int					n;
+	int					i;
+
+	arm_timer(data, reaper);
+	n = epoll_wait(reaper->epfd, ev, REAP_EVENTS, -1);
+	if (n == -1 && errno != EINTR)
+		return (-1);
+	i = 0;
+	while (i < n)
+		handle_event(data, reaper, ev[i++].data.u32);
+	return (0);
+}
+
+/**
+ * Waits for every stage of the pipeline and records its wait status.
+ *
+ * Stages are reaped in the order they exit by an epoll loop over their
+ * process descriptors, or over a signalfd receiving SIGCHLD when process
+ * descriptors are not available. The same loop enforces the deadlines set
+ * with --timeout and --stage-timeout with a timerfd. If the loop cannot be
+ * set up or fails, the remaining stages are waited for one by one in
+ * pipeline order, without deadlines.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages and
+ *                     their process IDs.
+ */
+void	reap_stages(t_data *data)
+{
+	t_reaper	reaper;
+	int			ok;
+	int			i;
+
+	ok = (reaper_open(data, &reaper) == 0);
+	while (ok && stages_left(data) > 0)
+		ok = (reaper_wait(data, &reaper) == 0);
+	reaper_close(data, &reaper);
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		if (data->stages[i].status == -1 && data->pids[i] > 0)
+			wait_stage(data, i);
+		i++;
+	}
+}
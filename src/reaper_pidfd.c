@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   reaper_pidfd.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:02:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:53:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Closes the process descriptors still held for the stages.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ */
+void	close_pidfds(t_data *data)
+{
+	int	i;
+
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		if (data->stages[i].pidfd != -1)
+			close(data->stages[i].pidfd);
+		data->stages[i].pidfd = -1;
+		i++;
+	}
+}
+
+/**
+ * Opens a process descriptor for a stage still running and adds it to the
+ * epoll instance, tagged with the index of the stage.
+ *
+ * A stage that already exited keeps its process until it is reaped, so its
+ * descriptor can still be opened and is readable right away.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] epfd The epoll instance.
+ * @param[in] i Index of the stage.
+ * @return 1 if the stage is watched, 0 if it needs no watching, -1 on error.
+ */
+static int	watch_stage(t_data *data, int epfd, int i)
+{
+	struct epoll_event	ev;
+	t_stage				*stage;
+
+	stage = &data->stages[i];
+	if (stage->status != -1 || data->pids[i] <= 0 || stage->remote != -1)
+		return (0);
+	stage->pidfd = syscall(SYS_pidfd_open, data->pids[i], 0);
+	if (stage->pidfd == -1)
+		return (-1);
+	ev.events = EPOLLIN;
+	ev.data.u32 = i;
+	if (epoll_ctl(epfd, EPOLL_CTL_ADD, stage->pidfd, &ev) == -1)
+		return (-1);
+	return (1);
+}
+
+/**
+ * Watches every stage still running, see `watch_stage`.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] epfd The epoll instance.
+ * @return The number of stages watched, or -1 on error.
+ */
+int	watch_pidfds(t_data *data, int epfd)
+{
+	int	watched;
+	int	ret;
+	int	i;
+
+	watched = 0;
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		ret = watch_stage(data, epfd, i);
+		if (ret < 0)
+			return (-1);
+		watched += ret;
+		i++;
+	}
+	return (watched);
+}
+
+/**
+ * Reaps a stage whose process descriptor became readable, which means it
+ * exited, and records its wait status and resource usage. Closing the
+ * process descriptor also removes it from the epoll instance.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage.
+ */
+void	reap_stage(t_data *data, int i)
+{
+	t_stage	*stage;
+
+	stage = &data->stages[i];
+	if (stage->status == -1)
+		wait_stage(data, i);
+	if (stage->pidfd != -1)
+		close(stage->pidfd);
+	stage->pidfd = -1;
+}
+
+/**
+ * Sends a signal to a stage that was not reaped yet, with every process it
+ * started.
+ *
+ * The signal goes to the process group of the stage, see `launch_stage`, so
+ * that a child that outlives the stage cannot keep its pipes open past the
+ * deadline. The group keeps the ID of the stage, which cannot be reused
+ * while the stage is not reaped. If the group is gone, the stage alone is
+ * signaled through its process descriptor when it has one, or with `kill`.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage.
+ * @param[in] sig The signal to send.
+ */
+void	signal_stage(t_data *data, int i, int sig)
+{
+	t_stage	*stage;
+
+	stage = &data->stages[i];
+	if (stage->status != -1 || kill(-data->pids[i], sig) == 0)
+		return ;
+	if (stage->pidfd != -1
+		&& syscall(SYS_pidfd_send_signal, stage->pidfd, sig, NULL, 0) == 0)
+		return ;
+	kill(data->pids[i], sig);
+}
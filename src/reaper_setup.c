@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   reaper_setup.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:50:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Watches SIGCHLD through a signalfd, for kernels without process
+ * descriptors or when there are too many stages to hold one for each.
+ *
+ * SIGCHLD is blocked so that it is queued on the signalfd, then the stages
+ * that exited before are reaped right away.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in,out] reaper The descriptors of the wait loop.
+ * @return 0 on success, -1 on error.
+ */
+static int	watch_signalfd(t_data *data, t_reaper *reaper)
+{
+	struct epoll_event	ev;
+	sigset_t			mask;
+
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGCHLD);
+	if (sigprocmask(SIG_BLOCK, &mask, &reaper->old_mask) == -1)
+		return (-1);
+	reaper->sfd = signalfd(-1, &mask, SFD_CLOEXEC);
+	if (reaper->sfd == -1)
+	{
+		sigprocmask(SIG_SETMASK, &reaper->old_mask, NULL);
+		return (-1);
+	}
+	ev.events = EPOLLIN;
+	ev.data.u32 = REAP_SIGNAL;
+	if (epoll_ctl(reaper->epfd, EPOLL_CTL_ADD, reaper->sfd, &ev) == -1)
+		return (-1);
+	reap_ready(data);
+	return (0);
+}
+
+/**
+ * Adds a timerfd to the wait loop, armed by `arm_timer` to the next
+ * deadline.
+ *
+ * @param[in,out] reaper The descriptors of the wait loop.
+ * @return 0 on success, -1 on error.
+ */
+static int	watch_timer(t_reaper *reaper)
+{
+	struct epoll_event	ev;
+
+	reaper->tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	if (reaper->tfd == -1)
+		return (-1);
+	ev.events = EPOLLIN;
+	ev.data.u32 = REAP_TIMER;
+	return (epoll_ctl(reaper->epfd, EPOLL_CTL_ADD, reaper->tfd, &ev));
+}
+
+/**
+ * Arms the timer of the wait loop to the next time a stage must be
+ * signaled, or disarms it when there is none.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ * @param[in] reaper The descriptors of the wait loop.
+ */
+void	arm_timer(t_data *data, t_reaper *reaper)
+{
+	struct itimerspec	its;
+	long				next;
+
+	if (reaper->tfd == -1)
+		return ;
+	ft_bzero(&its, sizeof(its));
+	next = next_wake(data);
+	its.it_value.tv_sec = next / 1000;
+	its.it_value.tv_nsec = next % 1000 * 1000000;
+	timerfd_settime(reaper->tfd, TFD_TIMER_ABSTIME, &its, NULL);
+}
+
+/**
+ * Sets up the wait loop of `reap_stages`.
+ *
+ * Every stage is watched through a process descriptor when possible, through
+ * a signalfd otherwise. A timer is added when a stage has a deadline. A
+ * deadline that cannot be enforced is reported, the stages are still waited
+ * for.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[out] reaper The descriptors of the wait loop.
+ * @return 0 on success, -1 if the stages cannot be watched, in which case
+ *         `reaper_close` must still be called.
+ */
+int	reaper_open(t_data *data, t_reaper *reaper)
+{
+	reaper->sfd = -1;
+	reaper->tfd = -1;
+	reaper->epfd = epoll_create1(EPOLL_CLOEXEC);
+	if (reaper->epfd == -1)
+		return (-1);
+	if (watch_pidfds(data, reaper->epfd) < 0)
+	{
+		close_pidfds(data);
+		if (watch_signalfd(data, reaper) == -1)
+			return (-1);
+	}
+	if (watch_remotes(data, reaper->epfd) == -1)
+		return (-1);
+	if (next_wake(data) && watch_timer(reaper) == -1)
+		ft_printf("pipex: timeout: %s\n", strerror(errno));
+	return (0);
+}
+
+/**
+ * Releases the descriptors of the wait loop and restores the signal mask.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in,out] reaper The descriptors of the wait loop.
+ */
+void	reaper_close(t_data *data, t_reaper *reaper)
+{
+	close_pidfds(data);
+	if (reaper->tfd != -1)
+		close(reaper->tfd);
+	if (reaper->sfd != -1)
+	{
+		close(reaper->sfd);
+		sigprocmask(SIG_SETMASK, &reaper->old_mask, NULL);
+	}
+	if (reaper->epfd != -1)
+		close(reaper->epfd);
+}
@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   rewrite.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:12:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:14:20 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Returns the table of rewrite rules.
+ *
+ * Rules run in table order, each one over every stage, until a full pass
+ * leaves the pipeline unchanged. A rule must never change the output of the
+ * pipeline nor its exit status. New rules are added here. The table ends with
+ * a NULL name.
+ *
+ * @return Pointer to the static rule table.
+ */
+static const t_rule	*rule_table(void)
+{
+	static const t_rule	table[] = {
+	{"leading-cat", rule_leading_cat},
+	{"cat-cat", rule_cat_cat},
+	{"copy", rule_copy},
+	{NULL, NULL}
+	};
+
+	return (table);
+}
+
+/**
+ * Applies one rule at every stage of the pipeline.
+ *
+ * When the rule changes the pipeline it is tried again at the same index, as
+ * the stage now there may match as well. Applied rules are reported with
+ * --print-plan.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] rule The rule to apply.
+ * @return 1 if the pipeline changed, 0 otherwise.
+ */
+static int	apply_rule(t_data *data, const t_rule *rule)
+{
+	int	changed;
+	int	i;
+
+	changed = 0;
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		if (rule->apply(data, i))
+		{
+			changed = 1;
+			if (data->opts.print_plan)
+				ft_printf("pipex: rewrite: %s at stage %d\n", rule->name,
+					i + 1);
+		}
+		else
+			i++;
+	}
+	return (changed);
+}
+
+/**
+ * Checks whether an option names stages or pipes by their number, or
+ * reports on every stage, as --pipestatus and --stats do.
+ *
+ * @param[in] opts Options parsed from the command line.
+ * @return 1 if such an option was given, 0 otherwise.
+ */
+static int	numbered_options(t_opts *opts)
+{
+	return (opts->pipe_sizes || opts->stage_timeouts || opts->meter
+		|| opts->parallel || opts->tees || opts->stage_cpus
+		|| opts->stage_nice || opts->stage_sched || opts->stage_ioprio
+		|| opts->pipestatus || opts->pipestatus_json || opts->stats
+		|| opts->stats_file);
+}
+
+/**
+ * Simplifies the planned pipeline before any pipe or process is created,
+ * with --rewrite.
+ *
+ * Stages that only copy their input, like a leading `cat` or the second `cat`
+ * of `cat | cat`, cost a process and a pipe for nothing. The rules of
+ * `rule_table` drop or replace them, keeping at least one stage. Dropping a
+ * stage renumbers the ones after it, so the pass is skipped when an option
+ * names stages or pipes by number, or reports one entry per stage: the final
+ * plan then always matches the commands as given.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ */
+void	rewrite_stages(t_data *data)
+{
+	const t_rule	*rule;
+	int				changed;
+
+	if (numbered_options(&data->opts))
+	{
+		if (data->opts.print_plan)
+			ft_printf("pipex: rewrite: skipped, stages named by number\n");
+		return ;
+	}
+	changed = 1;
+	while (changed)
+	{
+		changed = 0;
+		rule = rule_table();
+		while (rule->name)
+		{
+			if (apply_rule(data, rule))
+				changed = 1;
+			rule++;
+		}
+	}
+}
+
+/**
+ * Prints the stages that will run to STDERR, one line per stage.
+ *
+ * Each line shows the command followed by how it runs, "copy" for a stage
+ * turned into a plain file copy, "builtin" for an in-process command, the
+ * resolved path, followed by the number of workers with --parallel, or
+ * "not found".
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ */
+void	print_plan(t_data *data)
+{
+	t_stage	*stage;
+	int		i;
+	int		j;
+
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		stage = &data->stages[i];
+		ft_printf("pipex: plan: stage %d:", i + 1);
+		j = 0;
+		while (stage->argv && stage->argv[j])
+			ft_printf(" %s", stage->argv[j++]);
+		if (stage->builtin == builtin_copy_file)
+			ft_printf(" [copy]\n");
+		else if (stage->builtin)
+			ft_printf(" [builtin]\n");
+		else if (stage->path && stage->workers)
+			ft_printf(" [%s x%d]\n", stage->path, stage->workers);
+		else if (stage->path)
+			ft_printf(" [%s]\n", stage->path);
+		else
+			ft_printf(" [not found]\n");
+		i++;
+	}
+}
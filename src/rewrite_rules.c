@@ -0,0 +1,119 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   rewrite_rules.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:12:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:30:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Checks whether a stage is a `cat` that only copies STDIN to STDOUT.
+ *
+ * The stage must be runnable, either as the builtin or as a resolved binary,
+ * so that dropping it cannot hide a "command not found" exit status.
+ *
+ * @param[in] stage The stage to check.
+ * @return 1 if the stage is a plain `cat`, 0 otherwise.
+ */
+static int	is_plain_cat(t_stage *stage)
+{
+	if (!stage->argv || !stage->argv[0])
+		return (0);
+	if (ft_strncmp(stage->argv[0], "cat", 4) || !cat_accepts(stage->argv))
+		return (0);
+	if (stage->builtin == builtin_copy_file)
+		return (0);
+	return (stage->builtin == builtin_cat || stage->path != NULL);
+}
+
+/**
+ * Removes a stage from the pipeline, shifting the following stages down.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage to remove.
+ */
+static void	drop_stage(t_data *data, int i)
+{
+	free_array(data->stages[i].argv);
+	free(data->stages[i].path);
+	if (data->stages[i].exec_fd != -1)
+		close(data->stages[i].exec_fd);
+	ft_memmove(&data->stages[i], &data->stages[i + 1],
+		sizeof(*data->stages) * (data->cmd_count - i - 1));
+	data->cmd_count--;
+}
+
+/**
+ * Drops a plain `cat` reading the input file, the next stage reads the file
+ * itself.
+ *
+ * Only applies when the input file is open, otherwise the `cat` is what
+ * turns the missing file into an empty input for the next stage.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage to try.
+ * @return 1 if the stage was dropped, 0 otherwise.
+ */
+int	rule_leading_cat(t_data *data, int i)
+{
+	if (i != 0 || data->cmd_count < 2 || data->input_fd < 0)
+		return (0);
+	if (!is_plain_cat(&data->stages[0]))
+		return (0);
+	drop_stage(data, 0);
+	return (1);
+}
+
+/**
+ * Collapses two adjacent plain `cat` stages into one.
+ *
+ * The first one is kept, so a `cat | cat` at the end of the pipeline still
+ * gives the exit status of a `cat`. Not applied to the first stage when the
+ * input file could not be opened, as that `cat` fails while the one after it
+ * succeeds on an empty input.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage to try.
+ * @return 1 if the following stage was dropped, 0 otherwise.
+ */
+int	rule_cat_cat(t_data *data, int i)
+{
+	if (i + 1 >= data->cmd_count || (i == 0 && data->input_fd < 0))
+		return (0);
+	if (!is_plain_cat(&data->stages[i]) || !is_plain_cat(&data->stages[i + 1]))
+		return (0);
+	drop_stage(data, i + 1);
+	return (1);
+}
+
+/**
+ * Turns a pipeline made of a single plain `cat` into a copy of the input file
+ * to the output file with `copy_file_range`, see `builtin_copy_file`.
+ *
+ * Skipped with --no-builtins, which asks for external binaries only, and
+ * when the input file could not be opened.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage to try.
+ * @return 1 if the stage was replaced, 0 otherwise.
+ */
+int	rule_copy(t_data *data, int i)
+{
+	if (data->cmd_count != 1 || !data->opts.builtins || data->input_fd < 0)
+		return (0);
+	if (!is_plain_cat(&data->stages[i]))
+		return (0);
+	free(data->stages[i].path);
+	data->stages[i].path = NULL;
+	if (data->stages[i].exec_fd != -1)
+		close(data->stages[i].exec_fd);
+	data->stages[i].exec_fd = -1;
+	data->stages[i].builtin = builtin_copy_file;
+	return (1);
+}
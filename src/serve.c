@@ -0,0 +1,187 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   serve.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:58:40 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Handles the signals queued on the signalfd of the server.
+ *
+ * Pipelines that exited are reaped, helpers of --zygotes that exited are
+ * replaced. SIGINT and SIGTERM stop the server.
+ *
+ * @param[in] serve The server.
+ * @return 1 if the server must stop, 0 otherwise.
+ */
+static int	handle_signals(t_serve *serve)
+{
+	struct signalfd_siginfo	info;
+	pid_t					pid;
+	int						stop;
+
+	stop = 0;
+	while (read(serve->sfd, &info, sizeof(info)) == sizeof(info))
+	{
+		if (info.ssi_signo != SIGCHLD)
+			stop = 1;
+	}
+	pid = 1;
+	while (pid > 0)
+	{
+		pid = waitpid(-1, NULL, WNOHANG);
+		refill_zygote(&serve->tmpl, pid);
+	}
+	return (stop);
+}
+
+/**
+ * Starts the pipeline of a request in a process of its own.
+ *
+ * The process makes the descriptors of the client its standard input,
+ * output and error, moves to the working directory of the client and runs
+ * the pipeline from the template data of the server, see `job_run`. The
+ * exit code of the pipeline is then sent back on the connection. The
+ * server does not wait for it and goes back to accepting requests.
+ *
+ * @param[in] serve The server.
+ * @param[in,out] req The request, freed.
+ */
+static void	start_request(t_serve *serve, t_request *req)
+{
+	pid_t	pid;
+	int		exit_code;
+
+	exit_code = ERROR;
+	pid = fork();
+	if (pid == 0)
+	{
+		serve_close(serve);
+		if (dup2(req->fds[0], STDIN_FILENO) == -1
+			|| dup2(req->fds[1], STDOUT_FILENO) == -1
+			|| dup2(req->fds[2], STDERR_FILENO) == -1)
+			exit(ERROR);
+		if (chdir(req->payload) == -1)
+			ft_printf("pipex: %s: %s\n", req->payload, strerror(errno));
+		else
+			exit_code = job_run(&serve->tmpl, req->ac, req->av);
+		write(req->conn, &exit_code, sizeof(exit_code));
+		free_request(req);
+		exit(exit_code);
+	}
+	if (pid == -1)
+		write(req->conn, &exit_code, sizeof(exit_code));
+	free_request(req);
+}
+
+/**
+ * Receives what arrived of a request and starts its pipeline once it is
+ * complete.
+ *
+ * The request is moved out of its slot before it starts, which frees the
+ * slot. The commands of the pipeline are resolved by the server before it
+ * starts, see `job_resolve`, so that the next pipelines running them find
+ * them resolved. A connection that sends an invalid request is closed
+ * without a reply.
+ *
+ * @param[in,out] serve The server.
+ * @param[in,out] slot The slot of the connection that became readable.
+ */
+static void	serve_receive(t_serve *serve, t_request *slot)
+{
+	t_request	req;
+
+	if (recv_request(slot))
+	{
+		free_request(slot);
+		return ;
+	}
+	if (!slot->av)
+		return ;
+	req = *slot;
+	slot->deadline = 0;
+	job_resolve(&serve->tmpl, req.ac, req.av);
+	start_request(serve, &req);
+}
+
+/**
+ * Waits for signals, changes of the PATH directories, connections and the
+ * requests they send, until SIGINT or SIGTERM.
+ *
+ * @param[in,out] serve The server.
+ */
+static void	serve_loop(t_serve *serve)
+{
+	struct pollfd	pfd[3 + SERVE_PENDING];
+	int				stop;
+	int				i;
+
+	stop = 0;
+	while (!stop)
+	{
+		serve_pollfds(serve, pfd);
+		if (poll(pfd, 3 + SERVE_PENDING, serve_expire(serve)) == -1
+			&& errno != EINTR)
+			stop = 1;
+		if (!stop && pfd[0].revents & POLLIN)
+			stop = handle_signals(serve);
+		if (!stop && pfd[1].revents & POLLIN)
+			refresh_paths(serve);
+		i = 0;
+		while (!stop && i < SERVE_PENDING)
+		{
+			if (pfd[3 + i].revents)
+				serve_receive(serve, &serve->pending[i]);
+			i++;
+		}
+		if (!stop && pfd[2].revents & POLLIN)
+			serve_accept(serve);
+	}
+}
+
+/**
+ * Runs as a server accepting pipelines on a Unix socket, until SIGINT or
+ * SIGTERM.
+ *
+ * Every pipeline submitted with --submit is started right away from the
+ * same template data, so PATH is parsed once and each command is looked up
+ * once for all of them, until a PATH directory changes, see
+ * `refresh_paths`. The pipelines run with the environment of the server.
+ *
+ * @param[in,out] opts Options parsed from the command line, freed.
+ * @param[in] extra Number of pipeline arguments after the options, which
+ *                  --serve does not take.
+ * @param[in] envp The environment variables.
+ * @return 0 once stopped, 1 on error.
+ */
+int	run_serve(t_opts *opts, int extra, char **envp)
+{
+	t_serve	serve;
+	int		error;
+
+	error = 1;
+	if (extra > 0)
+		ft_putendl_fd("pipex: --serve takes no pipeline arguments", 2);
+	else
+		error = serve_init(&serve, opts, envp);
+	if (!error)
+	{
+		serve_loop(&serve);
+		unlink(opts->serve);
+	}
+	if (extra == 0)
+	{
+		serve_close(&serve);
+		free_zygotes(&serve.tmpl);
+		free_stages(&serve.tmpl);
+	}
+	free_options(opts);
+	return (error);
+}
@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   serve_conn.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:46:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:46:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Checks that a client runs as the same user as the server.
+ *
+ * Pipelines run with the privileges of the server, so a client of another
+ * user, let in by the mode of the socket, could otherwise run commands as
+ * the user of the server.
+ *
+ * @param[in] conn The connection of the client.
+ * @return 0 if the client may submit pipelines, 1 otherwise.
+ */
+static int	check_peer(int conn)
+{
+	struct ucred	cred;
+	socklen_t		len;
+
+	len = sizeof(cred);
+	if (getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &len) == -1)
+		return (1);
+	if (cred.uid == getuid())
+		return (0);
+	ft_printf("pipex: --serve: client of uid %d refused\n", (int)cred.uid);
+	return (1);
+}
+
+/**
+ * Accepts a connection into a free slot of the server.
+ *
+ * The connection is non-blocking and its request is received piece by piece
+ * by the wait loop as it arrives, see `recv_request`, so a client that is
+ * slow to send its request never holds up the others. It must be complete
+ * within SERVE_RECV_TIMEOUT seconds, see `serve_expire`. The listening
+ * socket is not polled while every slot is taken, see `serve_pollfds`.
+ *
+ * @param[in,out] serve The server.
+ */
+void	serve_accept(t_serve *serve)
+{
+	t_request	*req;
+	int			i;
+
+	i = 0;
+	while (i < SERVE_PENDING && serve->pending[i].deadline)
+		i++;
+	if (i == SERVE_PENDING)
+		return ;
+	req = &serve->pending[i];
+	ft_bzero(req, sizeof(*req));
+	ft_memset(req->fds, -1, sizeof(req->fds));
+	req->conn = accept4(serve->sock, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK);
+	if (req->conn == -1)
+		return ;
+	if (check_peer(req->conn))
+	{
+		close(req->conn);
+		return ;
+	}
+	req->deadline = now_ms() + SERVE_RECV_TIMEOUT * 1000;
+}
+
+/**
+ * Closes the connections whose request did not arrive in time, without a
+ * reply.
+ *
+ * @param[in,out] serve The server.
+ * @return Time in ms until the next deadline, to wait for at most, or -1 if
+ *         no request is being received.
+ */
+int	serve_expire(t_serve *serve)
+{
+	t_request	*req;
+	long		now;
+	long		wait;
+	int			i;
+
+	now = now_ms();
+	wait = -1;
+	i = 0;
+	while (i < SERVE_PENDING)
+	{
+		req = &serve->pending[i++];
+		if (req->deadline && req->deadline <= now)
+			free_request(req);
+		else if (req->deadline && (wait == -1 || req->deadline - now < wait))
+			wait = req->deadline - now;
+	}
+	return (wait);
+}
+
+/**
+ * Fills the descriptors watched by the wait loop of the server: the
+ * signalfd, the inotify descriptor, the listening socket while a slot is
+ * free, then the connection of every slot in use. Unused entries are -1,
+ * which `poll` skips.
+ *
+ * @param[in] serve The server.
+ * @param[out] pfd Array of 3 + SERVE_PENDING entries.
+ */
+void	serve_pollfds(t_serve *serve, struct pollfd *pfd)
+{
+	int	i;
+
+	pfd[0].fd = serve->sfd;
+	pfd[1].fd = serve->watch;
+	pfd[2].fd = -1;
+	i = 0;
+	while (i < SERVE_PENDING)
+	{
+		pfd[3 + i].fd = -1;
+		if (serve->pending[i].deadline)
+			pfd[3 + i].fd = serve->pending[i].conn;
+		else
+			pfd[2].fd = serve->sock;
+		i++;
+	}
+	i = 0;
+	while (i < 3 + SERVE_PENDING)
+	{
+		pfd[i].events = POLLIN;
+		pfd[i++].revents = 0;
+	}
+}
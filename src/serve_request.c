@@ -0,0 +1,175 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   serve_request.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:51:27 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:46:30 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Receives the header of a request: the length of the rest of the frame,
+ * with the descriptors of the client.
+ *
+ * The connection is non-blocking, so nothing is received if the header did
+ * not arrive yet.
+ *
+ * @param[in,out] req The request, whose `fds` and `len` are set.
+ * @return 0 on success or if the header did not arrive yet, 1 if the header
+ *         or the descriptors are missing.
+ */
+static int	recv_header(t_request *req)
+{
+	struct msghdr	msg;
+	struct iovec	iov;
+	struct cmsghdr	*cmsg;
+	char			ctrl[CMSG_SPACE(sizeof(int) * SERVE_FDS)];
+	ssize_t			n;
+
+	ft_bzero(&msg, sizeof(msg));
+	iov.iov_base = &req->len;
+	iov.iov_len = sizeof(req->len);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	n = recvmsg(req->conn, &msg, MSG_CMSG_CLOEXEC);
+	if (n == -1 && errno == EAGAIN)
+		return (0);
+	cmsg = NULL;
+	if (n > 0)
+		cmsg = CMSG_FIRSTHDR(&msg);
+	if (!cmsg || cmsg->cmsg_level != SOL_SOCKET
+		|| cmsg->cmsg_type != SCM_RIGHTS
+		|| cmsg->cmsg_len != CMSG_LEN(sizeof(int) * SERVE_FDS))
+		return (1);
+	ft_memcpy(req->fds, CMSG_DATA(cmsg), sizeof(req->fds));
+	return (n != sizeof(req->len));
+}
+
+/**
+ * Reads what arrived of the rest of the frame of a request.
+ *
+ * @param[in,out] req The request, whose `payload` is allocated on the first
+ *                    call and `got` advanced.
+ * @return 0 on success, even if the frame is not complete yet, 1 if the
+ *         frame is too long, cut short or does not end in '\0'.
+ */
+static int	read_payload(t_request *req)
+{
+	ssize_t	n;
+
+	if (req->len == 0 || req->len > SERVE_MAX_FRAME)
+		return (1);
+	if (!req->payload)
+		req->payload = malloc(req->len);
+	n = 1;
+	while (req->payload && req->got < req->len && n > 0)
+	{
+		n = read(req->conn, req->payload + req->got, req->len - req->got);
+		if (n > 0)
+			req->got += n;
+	}
+	if (!req->payload || n == 0 || (n < 0 && errno != EAGAIN))
+		return (1);
+	return (req->got == req->len && req->payload[req->len - 1] != '\0');
+}
+
+/**
+ * Builds the argument vector of the pipeline of a request.
+ *
+ * The pipeline reads and writes the descriptors of the client, which the
+ * process running it makes its standard input and output, hence the
+ * "/dev/stdin" and "/dev/stdout" files. The strings of `av` point into the
+ * payload.
+ *
+ * @param[in,out] req The request, whose `av` and `ac` are set.
+ * @param[in] len Length of the payload.
+ * @return 0 on success, 1 if there are less than two commands or memory
+ *         runs out.
+ */
+static int	build_av(t_request *req, uint32_t len)
+{
+	size_t	i;
+	int		n;
+
+	n = 0;
+	i = 0;
+	while (i < len)
+		n += (req->payload[i++] == '\0');
+	if (n < 3)
+		return (1);
+	req->ac = n + 2;
+	req->av = ft_calloc(req->ac + 1, sizeof(char *));
+	if (!req->av)
+		return (1);
+	req->av[0] = "pipex";
+	req->av[1] = "/dev/stdin";
+	req->av[req->ac - 1] = "/dev/stdout";
+	i = ft_strlen(req->payload) + 1;
+	n = 2;
+	while (n < req->ac - 1)
+	{
+		req->av[n++] = req->payload + i;
+		i += ft_strlen(req->payload + i) + 1;
+	}
+	return (0);
+}
+
+/**
+ * Receives what arrived of a request, see `t_request` for the frame.
+ *
+ * Called each time the connection is readable, so that a slow client never
+ * holds up the server. The argument vector is built once the whole frame
+ * arrived.
+ *
+ * @param[in,out] req The request, set up by `serve_accept`, whose `av` is
+ *                    set once the request is complete.
+ * @return 0 on success, 1 if the frame is invalid, in which case the request
+ *         must be freed with `free_request`.
+ */
+int	recv_request(t_request *req)
+{
+	int	err;
+
+	err = 0;
+	if (req->fds[0] == -1)
+		err = recv_header(req);
+	if (!err && req->fds[0] != -1)
+		err = read_payload(req);
+	if (!err && req->payload && req->got == req->len)
+		err = build_av(req, req->len);
+	return (err);
+}
+
+/**
+ * Closes the connection and the descriptors of a request and frees it,
+ * which also frees its slot in the server.
+ *
+ * @param[in,out] req The request.
+ */
+void	free_request(t_request *req)
+{
+	int	i;
+
+	i = 0;
+	while (i < SERVE_FDS)
+	{
+		if (req->fds[i] != -1)
+			close(req->fds[i]);
+		req->fds[i++] = -1;
+	}
+	if (req->conn != -1)
+		close(req->conn);
+	req->conn = -1;
+	free(req->payload);
+	req->payload = NULL;
+	free(req->av);
+	req->av = NULL;
+	req->deadline = 0;
+}
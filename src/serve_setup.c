@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   serve_setup.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:44:51 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Opens the listening socket of a --serve run.
+ *
+ * A socket left behind at the same path by an earlier run is replaced.
+ *
+ * @param[out] serve The server, whose `sock` is set.
+ * @param[in] path Path of the socket.
+ * @return 0 on success, 1 on error, after a message is printed to STDERR.
+ */
+static int	serve_listen(t_serve *serve, char *path)
+{
+	struct sockaddr_un	addr;
+	struct stat			st;
+
+	ft_bzero(&addr, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	ft_strlcpy(addr.sun_path, path, sizeof(addr.sun_path));
+	if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode))
+		unlink(path);
+	errno = ENAMETOOLONG;
+	if (ft_strlen(path) >= sizeof(addr.sun_path))
+		serve->sock = -1;
+	else
+		serve->sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (serve->sock == -1
+		|| bind(serve->sock, (struct sockaddr *)&addr, sizeof(addr)) == -1
+		|| listen(serve->sock, SOMAXCONN) == -1)
+	{
+		ft_printf("pipex: %s: %s\n", path, strerror(errno));
+		return (1);
+	}
+	return (0);
+}
+
+/**
+ * Prepares a --serve run: parses PATH once, opens the socket, watches the
+ * PATH directories and forks the helpers of --zygotes, shared by every
+ * pipeline.
+ *
+ * SIGCHLD, SIGINT and SIGTERM are received through a signalfd, so that the
+ * server reaps its pipelines and stops cleanly from its wait loop.
+ *
+ * @param[out] serve The server.
+ * @param[in] opts Options parsed from the command line.
+ * @param[in] envp The environment variables, used by every pipeline.
+ * @return 0 on success, 1 on error.
+ */
+int	serve_init(t_serve *serve, t_opts *opts, char **envp)
+{
+	sigset_t	mask;
+
+	ft_bzero(serve, sizeof(*serve));
+	serve->tmpl.envp = envp;
+	serve->tmpl.opts = *opts;
+	serve->tmpl.cache.fd = -1;
+	serve->sock = -1;
+	serve->watch = -1;
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGCHLD);
+	sigaddset(&mask, SIGINT);
+	sigaddset(&mask, SIGTERM);
+	sigprocmask(SIG_BLOCK, &mask, &serve->old_mask);
+	serve->sfd = signalfd(-1, &mask, SFD_CLOEXEC | SFD_NONBLOCK);
+	serve->tmpl.paths = get_env_paths(envp);
+	if (serve->sfd == -1 || serve_listen(serve, opts->serve))
+		return (1);
+	watch_paths(serve);
+	start_zygotes(&serve->tmpl);
+	return (0);
+}
+
+/**
+ * Watches the PATH directories with inotify, so that the commands resolved
+ * by the server are dropped when a command is added, removed or changes
+ * mode, see `refresh_paths`.
+ *
+ * Directories that cannot be watched are skipped. Without inotify the
+ * commands are never dropped.
+ *
+ * @param[in,out] serve The server, whose `watch` is set.
+ */
+void	watch_paths(t_serve *serve)
+{
+	int	i;
+
+	serve->watch = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	i = 0;
+	while (serve->watch != -1 && serve->tmpl.paths && serve->tmpl.paths[i])
+		inotify_add_watch(serve->watch, serve->tmpl.paths[i++],
+			IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB);
+}
+
+/**
+ * Drops the commands resolved by the server and the index of the PATH
+ * directories after one of them changed.
+ *
+ * The events are read only to be discarded, any change is enough to
+ * resolve the commands again on their next use.
+ *
+ * @param[in,out] serve The server.
+ */
+void	refresh_paths(t_serve *serve)
+{
+	char	buf[4096];
+	ssize_t	n;
+
+	n = 1;
+	while (n > 0)
+		n = read(serve->watch, buf, sizeof(buf));
+	memo_free(&serve->tmpl);
+	path_index_free(&serve->tmpl);
+}
+
+/**
+ * Closes the descriptors of a --serve run, with the connections whose
+ * request is still being received, and restores the signal mask, in the
+ * server as it stops and in every pipeline it starts.
+ *
+ * @param[in,out] serve The server.
+ */
+void	serve_close(t_serve *serve)
+{
+	int	i;
+
+	i = 0;
+	while (i < SERVE_PENDING)
+	{
+		if (serve->pending[i].deadline)
+			free_request(&serve->pending[i]);
+		i++;
+	}
+	if (serve->sock != -1)
+		close(serve->sock);
+	if (serve->watch != -1)
+		close(serve->watch);
+	if (serve->sfd != -1)
+		close(serve->sfd);
+	serve->sock = -1;
+	serve->watch = -1;
+	serve->sfd = -1;
+	sigprocmask(SIG_SETMASK, &serve->old_mask, NULL);
+}
@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 14:40:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Returns the current CLOCK_MONOTONIC time in us.
+ *
+ * @return The time in us.
+ */
+long	now_us(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+/**
+ * Records the end of a stage that was just reaped.
+ *
+ * @param[out] stage The stage.
+ * @param[in] status Its wait status.
+ * @param[in] usage The resources it used, as returned by `wait4`.
+ */
+void	stage_exited(t_stage *stage, int status, struct rusage *usage)
+{
+	stage->status = status;
+	stage->usage = *usage;
+	stage->ended = now_us();
+}
+
+/**
+ * Waits for a stage with `wait4` and records its status and resource usage.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage.
+ */
+void	wait_stage(t_data *data, int i)
+{
+	struct rusage	usage;
+	int				status;
+
+	if (data->stages[i].remote != -1)
+		wait_remote(data, i);
+	else if (wait4(data->pids[i], &status, 0, &usage) == data->pids[i])
+		stage_exited(&data->stages[i], status, &usage);
+}
+
+/**
+ * Converts a time value of a resource usage into us.
+ *
+ * @param[in] tv The time value.
+ * @return The time in us.
+ */
+long	timeval_us(struct timeval *tv)
+{
+	return (tv->tv_sec * 1000000 + tv->tv_usec);
+}
+
+/**
+ * Returns the wall time of a stage, from its launch to its reap.
+ *
+ * @param[in] stage The stage.
+ * @return The time in us, or 0 if the stage was not reaped.
+ */
+long	stage_wall_us(t_stage *stage)
+{
+	if (stage->status == -1)
+		return (0);
+	return (stage->ended - stage->started);
+}
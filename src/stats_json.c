@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_json.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 14:40:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 14:40:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Appends the resource usage fields of a stage to a JSON object.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] usage The resources used by the stage.
+ */
+static void	add_usage_json(t_strbuf *sb, struct rusage *usage)
+{
+	sb_add(sb, ", \"maxrss_kb\": ");
+	sb_add_num(sb, usage->ru_maxrss);
+	sb_add(sb, ", \"minflt\": ");
+	sb_add_num(sb, usage->ru_minflt);
+	sb_add(sb, ", \"majflt\": ");
+	sb_add_num(sb, usage->ru_majflt);
+	sb_add(sb, ", \"nvcsw\": ");
+	sb_add_num(sb, usage->ru_nvcsw);
+	sb_add(sb, ", \"nivcsw\": ");
+	sb_add_num(sb, usage->ru_nivcsw);
+}
+
+/**
+ * Appends the JSON object describing the resources used by one stage.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage.
+ */
+static void	add_stage_stats_json(t_strbuf *sb, t_data *data, int i)
+{
+	t_stage	*stage;
+
+	stage = &data->stages[i];
+	sb_add(sb, "{\"stage\": ");
+	sb_add_num(sb, i + 1);
+	sb_add(sb, ", \"argv\": ");
+	add_argv_json(sb, stage->argv);
+	sb_add(sb, ", \"pid\": ");
+	sb_add_num(sb, data->pids[i]);
+	sb_add(sb, ", \"status\": ");
+	sb_add_num(sb, stage_exit_code(stage));
+	sb_add(sb, ", \"wall_us\": ");
+	sb_add_num(sb, stage_wall_us(stage));
+	sb_add(sb, ", \"user_us\": ");
+	sb_add_num(sb, timeval_us(&stage->usage.ru_utime));
+	sb_add(sb, ", \"sys_us\": ");
+	sb_add_num(sb, timeval_us(&stage->usage.ru_stime));
+	add_usage_json(sb, &stage->usage);
+	sb_add(sb, "}");
+}
+
+/**
+ * Writes the resources used by every stage to the file given with
+ * --stats=FILE.
+ *
+ * The file holds one object with a "stages" array, one object per stage with
+ * the same figures as the table of `print_stats`, times in us and the peak
+ * resident set size in KiB.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ */
+void	write_stats_json(t_data *data)
+{
+	t_strbuf	sb;
+	int			i;
+
+	ft_bzero(&sb, sizeof(sb));
+	sb_add(&sb, "{\"stages\": [");
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		if (i > 0)
+			sb_add(&sb, ", ");
+		add_stage_stats_json(&sb, data, i++);
+	}
+	sb_add(&sb, "]}\n");
+	write_report(&sb, data->opts.stats_file);
+}
@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_report.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 14:40:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 15:24:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Appends a number right-aligned in a column, preceded by a space.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] num The number, not negative.
+ * @param[in] width Width of the column.
+ */
+void	add_col(t_strbuf *sb, long num, int width)
+{
+	long	n;
+
+	n = num;
+	width--;
+	while (n > 9 && width-- > 0)
+		n /= 10;
+	while (width-- > 0)
+		sb_add(sb, " ");
+	sb_add(sb, " ");
+	sb_add_num(sb, num);
+}
+
+/**
+ * Appends the row of one stage to the table of `print_stats`.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] stage The stage.
+ * @param[in] i Index of the stage.
+ */
+static void	add_row(t_strbuf *sb, t_stage *stage, int i)
+{
+	int	j;
+
+	add_col(sb, i + 1, 5);
+	add_col(sb, stage_wall_us(stage), 11);
+	add_col(sb, timeval_us(&stage->usage.ru_utime), 11);
+	add_col(sb, timeval_us(&stage->usage.ru_stime), 11);
+	add_col(sb, stage->usage.ru_maxrss, 10);
+	add_col(sb, stage->usage.ru_minflt, 9);
+	add_col(sb, stage->usage.ru_majflt, 7);
+	add_col(sb, stage->usage.ru_nvcsw, 9);
+	add_col(sb, stage->usage.ru_nivcsw, 9);
+	add_col(sb, stage_exit_code(stage), 6);
+	j = 0;
+	while (stage->argv && stage->argv[j])
+	{
+		sb_add(sb, " ");
+		sb_add(sb, stage->argv[j++]);
+	}
+	sb_add(sb, "\n");
+}
+
+/**
+ * Prints the resources used by every stage to STDERR, one row per stage.
+ *
+ * Times are in us: wall time from launch to reap, user and system CPU time.
+ * Then come the peak resident set size in KiB, minor and major page faults,
+ * voluntary and involuntary context switches, the exit code and the command.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ */
+void	print_stats(t_data *data)
+{
+	t_strbuf	sb;
+	int			i;
+
+	ft_bzero(&sb, sizeof(sb));
+	sb_add(&sb, " stage     wall_us     user_us      sys_us  maxrss_kb"
+		"    minflt  majflt     nvcsw    nivcsw status command\n");
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		add_row(&sb, &data->stages[i], i);
+		i++;
+	}
+	sb_flush(&sb, STDERR_FILENO);
+}
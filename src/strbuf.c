@@ -0,0 +1,142 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strbuf.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:02:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 13:02:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Appends characters to a growable string.
+ *
+ * The buffer doubles when full. When an allocation fails the buffer is
+ * released and marked as failed, so callers can append without checking and
+ * test once before writing it out.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] str The characters to append.
+ * @param[in] len Number of characters to append.
+ */
+void	sb_add_len(t_strbuf *sb, const char *str, size_t len)
+{
+	char	*grown;
+	size_t	size;
+
+	if (sb->error)
+		return ;
+	if (sb->len + len > sb->size)
+	{
+		size = sb->size * 2 + len + 64;
+		grown = malloc(size);
+		if (!grown)
+		{
+			free(sb->str);
+			ft_bzero(sb, sizeof(*sb));
+			sb->error = 1;
+			return ;
+		}
+		if (sb->str)
+			ft_memcpy(grown, sb->str, sb->len);
+		free(sb->str);
+		sb->str = grown;
+		sb->size = size;
+	}
+	ft_memcpy(sb->str + sb->len, str, len);
+	sb->len += len;
+}
+
+/**
+ * Appends a NUL-terminated string to a growable string.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] str The string to append.
+ */
+void	sb_add(t_strbuf *sb, const char *str)
+{
+	sb_add_len(sb, str, ft_strlen(str));
+}
+
+/**
+ * Appends a number in decimal to a growable string.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] num The number to append.
+ */
+void	sb_add_num(t_strbuf *sb, long num)
+{
+	char			buf[24];
+	int				i;
+	unsigned long	n;
+
+	n = num;
+	if (num < 0)
+		n = -(unsigned long)num;
+	i = sizeof(buf);
+	buf[--i] = '0' + n % 10;
+	n /= 10;
+	while (n > 0)
+	{
+		buf[--i] = '0' + n % 10;
+		n /= 10;
+	}
+	if (num < 0)
+		buf[--i] = '-';
+	sb_add_len(sb, buf + i, sizeof(buf) - i);
+}
+
+/**
+ * Appends a string as a quoted JSON string to a growable string.
+ *
+ * Quotes and backslashes are escaped, and control characters are written as
+ * \uXXXX escapes. Other bytes are copied as they are.
+ *
+ * @param[in,out] sb The string to append to.
+ * @param[in] str The string to append.
+ */
+void	sb_add_json(t_strbuf *sb, const char *str)
+{
+	char	esc[6];
+
+	sb_add(sb, "\"");
+	while (*str)
+	{
+		if (*str == '"' || *str == '\\')
+			sb_add(sb, "\\");
+		if ((unsigned char)*str < 0x20)
+		{
+			ft_memcpy(esc, "\\u00", 4);
+			esc[4] = "0123456789abcdef"[(unsigned char)*str >> 4];
+			esc[5] = "0123456789abcdef"[*str & 0xf];
+			sb_add_len(sb, esc, 6);
+		}
+		else
+			sb_add_len(sb, str, 1);
+		str++;
+	}
+	sb_add(sb, "\"");
+}
+
+/**
+ * Writes a growable string to a file descriptor and releases it.
+ *
+ * @param[in,out] sb The string to write, empty afterwards.
+ * @param[in] fd Descriptor to write to.
+ * @return 0 on success, 1 if an allocation or the write failed.
+ */
+int	sb_flush(t_strbuf *sb, int fd)
+{
+	int	error;
+
+	error = sb->error;
+	if (!error && sb->len)
+		error = write_all(fd, sb->str, sb->len);
+	free(sb->str);
+	ft_bzero(sb, sizeof(*sb));
+	return (error);
+}
@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   submit.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:06:12 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 20:06:12 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Opens the infile and the outfile of a pipeline submitted with --submit.
+ *
+ * They are opened by the client, with its own working directory and
+ * permissions, and handed to the server as descriptors. A missing infile
+ * is reported and read as empty.
+ *
+ * @param[in] ac Count of pipeline arguments.
+ * @param[in] av Pipeline arguments: program name, infile, commands, outfile.
+ * @param[out] fds Input, output and error descriptors to send, -1 for the
+ *                 ones that could not be opened.
+ * @return 0 on success, 1 on error, after a message is printed to STDERR.
+ */
+static int	open_files(int ac, char **av, int *fds)
+{
+	fds[0] = -1;
+	fds[1] = -1;
+	fds[2] = STDERR_FILENO;
+	if (!ft_strncmp("here_doc", av[1], 9))
+	{
+		ft_putendl_fd("pipex: here_doc cannot be submitted", 2);
+		return (1);
+	}
+	fds[0] = open(av[1], O_RDONLY | O_CLOEXEC);
+	if (fds[0] == -1)
+	{
+		ft_printf("pipex: %s: %s\n", av[1], strerror(errno));
+		fds[0] = open("/dev/null", O_RDONLY | O_CLOEXEC);
+	}
+	fds[1] = open(av[ac - 1], O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fds[1] == -1)
+		ft_printf("pipex: %s: %s\n", av[ac - 1], strerror(errno));
+	return (fds[0] == -1 || fds[1] == -1);
+}
+
+/**
+ * Connects to the socket of a server started with --serve.
+ *
+ * @param[in] path Path of the socket.
+ * @return The connected socket, or -1 on error, after a message is printed
+ *         to STDERR.
+ */
+static int	connect_server(char *path)
+{
+	struct sockaddr_un	addr;
+	int					sock;
+
+	ft_bzero(&addr, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	ft_strlcpy(addr.sun_path, path, sizeof(addr.sun_path));
+	sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (sock == -1
+		|| connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == -1)
+	{
+		ft_printf("pipex: %s: %s\n", path, strerror(errno));
+		if (sock != -1)
+			close(sock);
+		return (-1);
+	}
+	return (sock);
+}
+
+/**
+ * Builds the payload of a request: the working directory of the client,
+ * then the commands, each ending in '\0'.
+ *
+ * @param[in] ac Count of pipeline arguments.
+ * @param[in] av Pipeline arguments: program name, infile, commands, outfile.
+ * @param[out] sb The payload.
+ * @return 0 on success, 1 on error.
+ */
+static int	build_payload(int ac, char **av, t_strbuf *sb)
+{
+	char	*cwd;
+	int		i;
+
+	ft_bzero(sb, sizeof(*sb));
+	cwd = getcwd(NULL, 0);
+	if (!cwd)
+		return (1);
+	sb_add_len(sb, cwd, ft_strlen(cwd) + 1);
+	free(cwd);
+	i = 2;
+	while (i < ac - 1)
+	{
+		sb_add_len(sb, av[i], ft_strlen(av[i]) + 1);
+		i++;
+	}
+	return (sb->error);
+}
+
+/**
+ * Sends a request to the server, see `t_request` for the frame.
+ *
+ * @param[in] sock The connected socket.
+ * @param[in] fds Input, output and error descriptors to send.
+ * @param[in] ac Count of pipeline arguments.
+ * @param[in] av Pipeline arguments: program name, infile, commands, outfile.
+ * @return 0 on success, 1 on error.
+ */
+static int	send_request(int sock, int *fds, int ac, char **av)
+{
+	struct msghdr	msg;
+	struct iovec	iov;
+	struct cmsghdr	*cmsg;
+	char			ctrl[CMSG_SPACE(sizeof(int) * SERVE_FDS)];
+	t_strbuf		sb;
+	uint32_t		len;
+
+	sb.error = build_payload(ac, av, &sb);
+	len = sb.len;
+	ft_bzero(&msg, sizeof(msg));
+	ft_bzero(ctrl, sizeof(ctrl));
+	iov.iov_base = &len;
+	iov.iov_len = sizeof(len);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int) * SERVE_FDS);
+	ft_memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * SERVE_FDS);
+	if (!sb.error && sendmsg(sock, &msg, MSG_NOSIGNAL) != sizeof(len))
+		sb.error = 1;
+	return (sb_flush(&sb, sock));
+}
+
+/**
+ * Runs the pipeline of the command line on a server started with --serve
+ * and waits for its exit code.
+ *
+ * The client opens the infile and the outfile, sends them to the server
+ * with its standard error and the commands, and exits with the exit code
+ * the server sends back once the pipeline is done.
+ *
+ * @param[in,out] opts Options parsed from the command line, freed.
+ * @param[in] ac Count of pipeline arguments.
+ * @param[in] av Pipeline arguments: program name, infile, commands, outfile.
+ * @return The exit code of the pipeline, or 1 if it could not be run.
+ */
+int	submit_job(t_opts *opts, int ac, char **av)
+{
+	int	fds[SERVE_FDS];
+	int	sock;
+	int	exit_code;
+
+	exit_code = ERROR;
+	sock = -1;
+	signal(SIGPIPE, SIG_IGN);
+	if (!open_files(ac, av, fds))
+		sock = connect_server(opts->submit);
+	if (sock != -1 && !send_request(sock, fds, ac, av)
+		&& read(sock, &exit_code, sizeof(exit_code)) != sizeof(exit_code))
+		exit_code = ERROR;
+	if (sock != -1)
+		close(sock);
+	if (fds[0] != -1)
+		close(fds[0]);
+	if (fds[1] != -1)
+		close(fds[1]);
+	free_options(opts);
+	return (exit_code);
+}
@@ -0,0 +1,145 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   subpipeline.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 18:15:02 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:38:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Copies the next command of a --tee or --input pipeline.
+ *
+ * The command ends at the next '|' that is not escaped, or at the end of the
+ * string. An escaped "\|" is copied as a plain '|', so a command such as
+ * "grep -E a\|b" can be given.
+ *
+ * @param[in,out] cmds Commands left, advanced past the command and its '|'.
+ * @return The command, or NULL if memory runs out.
+ */
+static char	*next_cmd(char **cmds)
+{
+	char	*cmd;
+	char	*s;
+	int		len;
+
+	s = *cmds;
+	cmd = ft_calloc(ft_strlen(s) + 1, sizeof(*cmd));
+	if (!cmd)
+		return (NULL);
+	len = 0;
+	while (*s && *s != '|')
+	{
+		if (s[0] == '\\' && s[1] == '|')
+			s++;
+		cmd[len++] = *s++;
+	}
+	if (*s)
+		s++;
+	*cmds = s;
+	return (cmd);
+}
+
+/**
+ * Counts the commands of a --tee or --input pipeline.
+ *
+ * @param[in] s Commands of the pipeline.
+ * @return One more than the number of '|' that are not escaped.
+ */
+static int	count_cmds(char *s)
+{
+	int	n;
+
+	n = 1;
+	while (*s)
+	{
+		if (s[0] == '\\' && s[1] == '|')
+			s++;
+		else if (*s == '|')
+			n++;
+		s++;
+	}
+	return (n);
+}
+
+/**
+ * Splits the commands of a --tee or --input pipeline on every '|' that is
+ * not escaped as "\|", see `next_cmd`.
+ *
+ * Unlike `ft_split`, empty commands are kept, so that the caller can reject
+ * them.
+ *
+ * @param[in] cmds Commands of the pipeline.
+ * @return A NULL-terminated array of commands, or NULL if memory runs out.
+ */
+static char	**split_cmds(char *cmds)
+{
+	char	**split;
+	int		n;
+	int		i;
+
+	n = count_cmds(cmds);
+	split = ft_calloc(n + 1, sizeof(*split));
+	i = 0;
+	while (split && i < n)
+	{
+		split[i] = next_cmd(&cmds);
+		if (!split[i++])
+		{
+			free_array(split);
+			return (NULL);
+		}
+	}
+	return (split);
+}
+
+/**
+ * Runs a pipeline of its own by executing pipex again, in a child.
+ *
+ * Used for the branches of --tee and the inputs of --input. The pipeline is
+ * an ordinary one, so its commands are resolved and its files are opened and
+ * reported exactly like those of the main pipeline. An empty command is
+ * rejected. A pipeline of one command gets a leading "cat", which the
+ * rewrite pass, enabled for it, drops, so the exit code of the pipeline
+ * stays the one of its command. SIGPIPE is restored first, since relays
+ * ignore it and an ignored signal stays ignored across `execve`. Only
+ * returns on error, by exiting.
+ *
+ * @param[in] data Pointer to the t_data structure holding the environment.
+ * @param[in] infile File the pipeline reads, such as /dev/stdin.
+ * @param[in] cmds Commands of the pipeline, separated by '|', see
+ *                 `split_cmds`.
+ * @param[in] outfile File the pipeline writes, such as /dev/stdout.
+ */
+void	exec_subpipeline(t_data *data, char *infile, char *cmds, char *outfile)
+{
+	char	**split;
+	char	**argv;
+	int		n;
+
+	signal(SIGPIPE, SIG_DFL);
+	split = split_cmds(cmds);
+	n = 0;
+	while (split && split[n] && *split[n])
+		n++;
+	if (split && split[n])
+		ft_printf("pipex: %s: empty command\n", cmds);
+	argv = ft_calloc(n + 7, sizeof(*argv));
+	if (!split || split[n] || !argv)
+		cleanup_n_exit(ERROR, data);
+	argv[0] = "pipex";
+	argv[1] = "--rewrite";
+	argv[2] = "--";
+	argv[3] = infile;
+	argv[4] = "cat";
+	ft_memcpy(argv + 4 + (n == 1), split, n * sizeof(*argv));
+	argv[4 + n + (n == 1)] = outfile;
+	execve("/proc/self/exe", argv, data->envp);
+	ft_printf("pipex: %s: %s\n", cmds, strerror(errno));
+	cleanup_n_exit(ERROR, data);
+}
@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tee.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 17:04:51 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:38:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Forks the relay of a --tee branch between two descriptors.
+ *
+ * The relay duplicates everything it reads from `in` to the branch and moves
+ * it on to `out`, see `tee_process`. The caller closes its copies of both
+ * descriptors.
+ *
+ * @param[in,out] data Pointer to the t_data structure.
+ * @param[in,out] tee The branch, receiving the process ID of the relay.
+ * @param[in] in Read end of the pipe the relay reads from.
+ * @param[in] out Pipe or file the relay writes to.
+ */
+static void	fork_tee(t_data *data, t_tee *tee, int in, int out)
+{
+	pid_t	pid;
+
+	pid = fork();
+	if (pid == -1)
+		cleanup_n_exit(ft_printf("fork error: %s\n", strerror(errno)), data);
+	if (pid == 0)
+		tee_process(data, tee, in, out);
+	tee->pid = pid;
+}
+
+/**
+ * Creates a close-on-exec pipe for a --tee relay.
+ *
+ * @param[in,out] data Pointer to the t_data structure, for error handling.
+ * @param[out] fds The two descriptors of the pipe.
+ */
+static void	tee_pipe(t_data *data, int *fds)
+{
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		cleanup_n_exit(ft_printf("pipex: Could not create pipe: %s\n",
+				strerror(errno)), data);
+}
+
+/**
+ * Inserts the relays of the --tee branches of a stage in a new pipe.
+ *
+ * For each branch a second pipe is created and a relay is forked between the
+ * read end of the pipe and the write end of the second one. The reading
+ * stage gets the read end of the second pipe in place of the first, so the
+ * stages are launched as without the option. Branches of the same stage are
+ * chained, each relay feeding the next one. Without --tee the list is empty
+ * and nothing changes.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the options.
+ * @param[in] edge Number of the pipe, which is also the number of the stage
+ *                 writing to it, counting from 1.
+ * @param[in,out] fds The two descriptors of the pipe.
+ */
+void	tee_edge(t_data *data, int edge, int *fds)
+{
+	t_list	*node;
+	t_tee	*tee;
+	int		out[2];
+
+	node = data->opts.tees;
+	while (node)
+	{
+		tee = node->content;
+		if (tee->stage == edge)
+		{
+			tee_pipe(data, out);
+			fork_tee(data, tee, fds[0], out[1]);
+			close(fds[0]);
+			close(out[1]);
+			fds[0] = out[0];
+		}
+		node = node->next;
+	}
+}
+
+/**
+ * Inserts the relays of the --tee branches of the last stage before the
+ * output file.
+ *
+ * The last stage then writes to a pipe, and the relays move its output on to
+ * the output file. When the output file could not be opened the last stage
+ * fails as usual and its branches do not run.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the output
+ *                     file, replaced by the write end of a pipe.
+ */
+void	tee_output(t_data *data)
+{
+	t_list	*node;
+	t_tee	*tee;
+	int		in[2];
+
+	node = data->opts.tees;
+	while (node && data->output_fd >= 0)
+	{
+		tee = node->content;
+		if (tee->stage == data->cmd_count)
+		{
+			tee_pipe(data, in);
+			fork_tee(data, tee, in[0], data->output_fd);
+			close(in[0]);
+			close(data->output_fd);
+			data->output_fd = in[1];
+		}
+		node = node->next;
+	}
+}
+/**
+ * Waits for the relays of the --tee branches, each of which waits for its
+ * branch, so that every outfile is complete when pipex exits. The exit code
+ * of each relay is the one of its branch, and a failure is recorded with
+ * `record_helper`.
+ *
+ * @param[in] data Pointer to the t_data structure holding the options.
+ */
+void	wait_tees(t_data *data)
+{
+	t_list	*node;
+	t_tee	*tee;
+	int		status;
+
+	node = data->opts.tees;
+	while (node)
+	{
+		tee = node->content;
+		if (tee->pid > 0 && waitpid(tee->pid, &status, 0) > 0)
+			record_helper(data, status);
+		tee->pid = 0;
+		node = node->next;
+	}
+}
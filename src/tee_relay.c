@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tee_relay.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 17:16:33 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:38:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Moves bytes the relay already duplicated to the branch on to its output.
+ *
+ * `tee` leaves the duplicated bytes in the input pipe, so exactly that many
+ * are consumed. Once the output is gone they are consumed into /dev/null,
+ * so the branch keeps getting the rest of the stream. Outputs `splice`
+ * cannot write to, such as a file opened in append mode for here_doc, are
+ * written with `read` and `write`.
+ *
+ * @param[in,out] out The output, replaced by `devnull` once it is gone.
+ * @param[in] len Number of bytes to consume.
+ * @param[in] devnull Descriptor of /dev/null.
+ */
+static void	drain(int *out, size_t len, int devnull)
+{
+	char	buf[BUILTIN_BUF_SIZE];
+	ssize_t	n;
+
+	while (len > 0)
+	{
+		n = splice(STDIN_FILENO, NULL, *out, NULL, len, SPLICE_F_MOVE);
+		if (n < 0 && errno == EINVAL && *out != devnull)
+		{
+			if (len < sizeof(buf))
+				n = read(STDIN_FILENO, buf, len);
+			else
+				n = read(STDIN_FILENO, buf, sizeof(buf));
+			if (n > 0 && write_all(*out, buf, n))
+				*out = devnull;
+		}
+		if (n <= 0 && *out == devnull)
+			return ;
+		if (n <= 0)
+			*out = devnull;
+		if (n > 0)
+			len -= n;
+	}
+}
+
+/**
+ * Copies the standard input to both the standard output and the branch.
+ *
+ * `tee` duplicates the pages of the input pipe into the branch pipe without
+ * copying them, and `drain` then moves the same bytes on to the output. When
+ * one side is gone the rest of the input is only copied to the other one,
+ * so a consumer that stops early, such as `head`, does not starve the other.
+ *
+ * @param[in] branch Write end of the pipe read by the branch, or -1.
+ */
+static void	run_tee(int branch)
+{
+	ssize_t	n;
+	int		out;
+	int		devnull;
+
+	devnull = open("/dev/null", O_WRONLY | O_CLOEXEC);
+	out = STDOUT_FILENO;
+	n = 1;
+	while (n > 0 && out != devnull && branch != -1)
+	{
+		n = tee(STDIN_FILENO, branch, TEE_CHUNK, 0);
+		if (n < 0 && errno == EPIPE)
+			branch = -1;
+		else if (n > 0)
+			drain(&out, n, devnull);
+	}
+	if (n != 0 && branch == -1 && out != devnull)
+		builtin_copy(STDIN_FILENO, out);
+	else if (n != 0 && branch != -1 && out == devnull)
+		builtin_copy(STDIN_FILENO, branch);
+	if (devnull != -1)
+		close(devnull);
+}
+
+/**
+ * Starts a --tee branch on a new pipe.
+ *
+ * The branch is a pipeline of its own reading the pipe through /dev/stdin,
+ * see `exec_subpipeline`.
+ *
+ * @param[in] data Pointer to the t_data structure of the relay.
+ * @param[in] tee The branch.
+ * @param[out] pid Process ID of the branch, or -1.
+ * @return Write end of the pipe read by the branch, or -1 if the branch
+ *         could not be started.
+ */
+static int	start_branch(t_data *data, t_tee *tee, pid_t *pid)
+{
+	int	branch[2];
+
+	*pid = -1;
+	if (pipe(branch) == -1)
+		return (-1);
+	*pid = fork();
+	if (*pid == 0)
+	{
+		if (dup2(branch[0], STDIN_FILENO) == -1)
+			cleanup_n_exit(ERROR, data);
+		close(branch[0]);
+		close(branch[1]);
+		exec_subpipeline(data, "/dev/stdin", tee->cmds, tee->outfile);
+	}
+	close(branch[0]);
+	if (*pid != -1)
+		return (branch[1]);
+	close(branch[1]);
+	return (-1);
+}
+
+/**
+ * Runs the relay of a --tee branch, in the child forked by `tee_edge` or
+ * `tee_output`.
+ *
+ * The two descriptors of the relay become its standard input and output and
+ * every other descriptor inherited from pipex is closed, like for a --meter
+ * relay. The branch is started on a new pipe and fed by `run_tee`, then
+ * waited for, and its exit code becomes the one of the relay, 128 plus the
+ * signal if it was killed, or ERROR if it could not be started.
+ *
+ * @param[in,out] data Pointer to the t_data structure of the child.
+ * @param[in] tee The branch.
+ * @param[in] in Read end of the pipe written by the stage.
+ * @param[in] out Pipe or file the stream goes on to.
+ */
+void	tee_process(t_data *data, t_tee *tee, int in, int out)
+{
+	pid_t	pid;
+	int		branch;
+	int		status;
+
+	signal(SIGPIPE, SIG_IGN);
+	if (dup2(in, STDIN_FILENO) == -1 || dup2(out, STDOUT_FILENO) == -1)
+		cleanup_n_exit(ERROR, data);
+	close_inherited(data);
+	branch = start_branch(data, tee, &pid);
+	run_tee(branch);
+	if (branch != -1)
+		close(branch);
+	if (pid <= 0 || waitpid(pid, &status, 0) == -1)
+		cleanup_n_exit(ERROR, data);
+	if (WIFSIGNALED(status))
+		cleanup_n_exit(128 + WTERMSIG(status), data);
+	cleanup_n_exit(WEXITSTATUS(status), data);
+}
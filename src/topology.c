@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:58:12 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 20:58:12 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Reads a number from the topology directory of a CPU.
+ *
+ * @param[in] cpu Number of the CPU.
+ * @param[in] name Name of the file in /sys/devices/system/cpu/cpuN/topology.
+ * @return The number, or -1 if the file cannot be read.
+ */
+static int	read_topology(int cpu, char *name)
+{
+	char	path[96];
+	char	buf[24];
+	char	*num;
+	ssize_t	n;
+	int		fd;
+
+	num = ft_itoa(cpu);
+	if (!num)
+		return (-1);
+	ft_strlcpy(path, "/sys/devices/system/cpu/cpu", sizeof(path));
+	ft_strlcat(path, num, sizeof(path));
+	ft_strlcat(path, "/topology/", sizeof(path));
+	ft_strlcat(path, name, sizeof(path));
+	free(num);
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	n = -1;
+	if (fd != -1)
+		n = read(fd, buf, sizeof(buf) - 1);
+	if (fd != -1)
+		close(fd);
+	if (n <= 0 || !ft_isdigit(buf[0]))
+		return (-1);
+	buf[n] = '\0';
+	return (ft_atoi(buf));
+}
+
+/**
+ * Tells whether a CPU comes before another in the placement order: by
+ * package, then core, then number, so that SMT siblings are adjacent and
+ * followed by the other cores of their package.
+ *
+ * @param[in] a A CPU.
+ * @param[in] b Another CPU.
+ * @return Non-zero if `a` comes before `b`.
+ */
+static int	cpu_before(t_cpu *a, t_cpu *b)
+{
+	if (a->package != b->package)
+		return (a->package < b->package);
+	if (a->core != b->core)
+		return (a->core < b->core);
+	return (a->cpu < b->cpu);
+}
+
+/**
+ * Sorts CPUs in the placement order, see `cpu_before`.
+ *
+ * An insertion sort, hosts have at most a few hundred CPUs.
+ *
+ * @param[in,out] cpus The CPUs.
+ * @param[in] count Number of CPUs.
+ */
+static void	sort_cpus(t_cpu *cpus, int count)
+{
+	t_cpu	cpu;
+	int		i;
+	int		j;
+
+	i = 1;
+	while (i < count)
+	{
+		cpu = cpus[i];
+		j = i;
+		while (j > 0 && cpu_before(&cpu, &cpus[j - 1]))
+		{
+			cpus[j] = cpus[j - 1];
+			j--;
+		}
+		cpus[j] = cpu;
+		i++;
+	}
+}
+
+/**
+ * Reads the topology of a set of CPUs.
+ *
+ * @param[in] allowed The CPUs.
+ * @param[out] cpus Array receiving one entry per CPU of the set.
+ * @return The number of CPUs.
+ */
+static int	list_cpus(cpu_set_t *allowed, t_cpu *cpus)
+{
+	int	count;
+	int	i;
+
+	count = 0;
+	i = 0;
+	while (i < CPU_SETSIZE)
+	{
+		if (CPU_ISSET(i, allowed))
+		{
+			cpus[count].cpu = i;
+			cpus[count].package = read_topology(i, "physical_package_id");
+			cpus[count++].core = read_topology(i, "core_id");
+		}
+		i++;
+	}
+	return (count);
+}
+
+/**
+ * Lists the CPUs pipex may run on in the placement order, see
+ * `cpu_before`.
+ *
+ * CPUs whose topology cannot be read sort by number.
+ *
+ * @param[out] count Number of CPUs listed.
+ * @return The CPU numbers, or NULL on error.
+ */
+int	*cpu_order(int *count)
+{
+	cpu_set_t	allowed;
+	t_cpu		*cpus;
+	int			*order;
+	int			i;
+
+	*count = 0;
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) == -1)
+		return (NULL);
+	cpus = malloc(sizeof(*cpus) * CPU_COUNT(&allowed));
+	order = NULL;
+	if (cpus)
+		*count = list_cpus(&allowed, cpus);
+	if (cpus)
+		order = malloc(sizeof(*order) * *count);
+	if (order)
+		sort_cpus(cpus, *count);
+	i = -1;
+	while (order && ++i < *count)
+		order[i] = cpus[i].cpu;
+	free(cpus);
+	return (order);
+}
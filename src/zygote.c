@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   zygote.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:33:02 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Forks one helper with a socket pair to hand it stages.
+ *
+ * @param[in] data Pointer to the t_data structure of pipex.
+ * @param[out] zygote The helper, left with a `sock` of -1 on error.
+ */
+static void	fork_zygote(t_data *data, t_zygote *zygote)
+{
+	int	sv[2];
+
+	zygote->pid = 0;
+	zygote->sock = -1;
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) == -1)
+		return ;
+	zygote->pid = fork();
+	if (zygote->pid == 0)
+	{
+		close(sv[0]);
+		zygote_main(data, sv[1]);
+	}
+	close(sv[1]);
+	if (zygote->pid > 0)
+		zygote->sock = sv[0];
+	else
+		close(sv[0]);
+	if (zygote->pid < 0)
+		zygote->pid = 0;
+}
+
+/**
+ * Forks the helpers requested with --zygotes, unless the pipeline inherited
+ * them.
+ *
+ * The helpers are fork servers, see `zygote_main`: a stage handed to one by
+ * `zygote_exec` costs a message and the fork of a small process instead of
+ * the fork of pipex. --batch and --serve fork them once, in their template
+ * data, and every pipeline they start uses the same warm helpers, see
+ * `job_run`. A single pipeline forks them for itself, never more than it
+ * has stages.
+ *
+ * @param[in,out] data Pointer to the t_data structure of pipex, receiving
+ *                     the helpers.
+ */
+void	start_zygotes(t_data *data)
+{
+	int	i;
+
+	if (data->zygotes)
+		return ;
+	data->zygote_count = data->opts.zygotes;
+	if (data->cmd_count > 0 && data->zygote_count > data->cmd_count)
+		data->zygote_count = data->cmd_count;
+	if (data->zygote_count <= 0)
+		return ;
+	data->zygotes = malloc(sizeof(*data->zygotes) * data->zygote_count);
+	if (!data->zygotes)
+		data->zygote_count = 0;
+	i = 0;
+	while (i < data->zygote_count)
+		fork_zygote(data, &data->zygotes[i++]);
+}
+
+/**
+ * Replaces a helper that exited, so that the pool stays full.
+ *
+ * Called by --batch and --serve with every process they reap, which may be
+ * one of their helpers.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the helpers.
+ * @param[in] pid Process ID of the process that was reaped.
+ * @return 1 if it was a helper, 0 otherwise.
+ */
+int	refill_zygote(t_data *data, pid_t pid)
+{
+	int	i;
+
+	i = 0;
+	while (pid > 0 && i < data->zygote_count && data->zygotes[i].pid != pid)
+		i++;
+	if (pid <= 0 || i == data->zygote_count)
+		return (0);
+	if (data->zygotes[i].sock != -1)
+		close(data->zygotes[i].sock);
+	fork_zygote(data, &data->zygotes[i]);
+	return (1);
+}
+
+/**
+ * Stops the helpers and frees them.
+ *
+ * Closing its socket makes a helper exit once every stage it started was
+ * reaped and every process sharing the socket closed it, it is then waited
+ * for. A pipeline using the helpers of --batch or --serve only closes its
+ * copies of the sockets, the helpers are not its children.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the helpers.
+ */
+void	free_zygotes(t_data *data)
+{
+	int	i;
+
+	i = 0;
+	while (i < data->zygote_count)
+	{
+		if (data->zygotes[i].sock != -1)
+			close(data->zygotes[i].sock);
+		data->zygotes[i++].sock = -1;
+	}
+	i = 0;
+	while (i < data->zygote_count)
+	{
+		if (data->zygotes[i].pid > 0)
+			waitpid(data->zygotes[i].pid, NULL, 0);
+		i++;
+	}
+	free(data->zygotes);
+	data->zygotes = NULL;
+	data->zygote_count = 0;
+}
@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   zygote_exec.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:50:00 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Builds the message handing a stage to a helper: the path of the command,
+ * then its arguments, each ending in '\0'.
+ *
+ * @param[in] stage The stage, with its command resolved.
+ * @param[out] sb The message.
+ */
+void	zygote_payload(t_stage *stage, t_strbuf *sb)
+{
+	int	i;
+
+	ft_bzero(sb, sizeof(*sb));
+	sb_add_len(sb, stage->path, ft_strlen(stage->path) + 1);
+	i = 0;
+	while (stage->argv[i])
+	{
+		sb_add_len(sb, stage->argv[i], ft_strlen(stage->argv[i]) + 1);
+		i++;
+	}
+}
+
+/**
+ * Sends the current stage to a helper, with its descriptors.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stage.
+ * @param[in] sock Socket of the helper.
+ * @param[in] fds The ZYGOTE_FDS descriptors of the stage: its standard
+ *                input, output and error, the socket its wait status is
+ *                sent on and its working directory.
+ * @return 0 on success, 1 on error.
+ */
+static int	send_stage(t_data *data, int sock, int *fds)
+{
+	struct msghdr	msg;
+	struct iovec	iov;
+	struct cmsghdr	*cmsg;
+	char			ctrl[CMSG_SPACE(sizeof(int) * ZYGOTE_FDS)];
+	t_strbuf		sb;
+
+	zygote_payload(&data->stages[data->child], &sb);
+	ft_bzero(&msg, sizeof(msg));
+	ft_bzero(ctrl, sizeof(ctrl));
+	iov.iov_base = sb.str;
+	iov.iov_len = sb.len;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int) * ZYGOTE_FDS);
+	ft_memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * ZYGOTE_FDS);
+	if (!sb.error && (sb.len > ZYGOTE_MSG_SIZE
+			|| sendmsg(sock, &msg, MSG_NOSIGNAL) != (ssize_t)sb.len))
+		sb.error = 1;
+	free(sb.str);
+	return (sb.error);
+}
+
+/**
+ * Starts the current stage in a helper forked by `start_zygotes`.
+ *
+ * The stages go to the helpers in turn. The helper forks the stage and
+ * replies with its process ID on a socket pair made for the stage, which
+ * it later sends the wait status of the stage on, since only the helper can
+ * wait for it, see `wait_remote`.
+ *
+ * @param[in,out] data Pointer to the t_data structure describing the stage.
+ * @param[in] in File descriptor to use as the standard input of the stage.
+ * @param[in] out File descriptor to use as the standard output of the stage.
+ * @return The process ID of the stage, or -1 if there is no helper or the
+ *         stage could not be started by one, in which case it is forked as
+ *         usual.
+ */
+pid_t	zygote_exec(t_data *data, int in, int out)
+{
+	t_zygote_reply	reply;
+	int				fds[ZYGOTE_FDS];
+	int				sv[2];
+	int				err;
+
+	if (data->zygote_count <= 0
+		|| socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) == -1)
+		return (-1);
+	fds[0] = in;
+	fds[1] = out;
+	fds[2] = STDERR_FILENO;
+	fds[3] = sv[1];
+	fds[4] = open(".", O_PATH | O_DIRECTORY | O_CLOEXEC);
+	err = (fds[4] == -1 || send_stage(data,
+				data->zygotes[data->child % data->zygote_count].sock, fds));
+	close(sv[1]);
+	close(fds[4]);
+	if (err || read(sv[0], &reply, sizeof(reply)) != sizeof(reply)
+		|| reply.pid <= 0)
+		reply.pid = -1;
+	if (reply.pid == -1)
+		close(sv[0]);
+	else
+		data->stages[data->child].remote = sv[0];
+	return (reply.pid);
+}
+
+/**
+ * Waits for a stage started by a helper and records the wait status and
+ * resource usage the helper sends once it reaped the stage.
+ *
+ * A helper that exits before that leaves the stage failed with ERROR.
+ *
+ * @param[in,out] data Pointer to the t_data structure holding the stages.
+ * @param[in] i Index of the stage.
+ */
+void	wait_remote(t_data *data, int i)
+{
+	t_zygote_reply	reply;
+	t_stage			*stage;
+
+	stage = &data->stages[i];
+	if (read(stage->remote, &reply, sizeof(reply)) != sizeof(reply))
+	{
+		ft_bzero(&reply, sizeof(reply));
+		reply.status = W_EXITCODE(ERROR, 0);
+	}
+	stage_exited(stage, reply.status, &reply.usage);
+	close(stage->remote);
+	stage->remote = -1;
+}
+
+/**
+ * Adds the sockets of the stages started by helpers to the epoll instance
+ * of `reap_stages`, tagged with the index of the stage, since pipex cannot
+ * wait for them.
+ *
+ * @param[in] data Pointer to the t_data structure holding the stages.
+ * @param[in] epfd The epoll instance.
+ * @return 0 on success, -1 on error.
+ */
+int	watch_remotes(t_data *data, int epfd)
+{
+	struct epoll_event	ev;
+	int					i;
+
+	i = 0;
+	while (i < data->cmd_count)
+	{
+		ev.events = EPOLLIN;
+		ev.data.u32 = i;
+		if (data->stages[i].remote != -1 && data->stages[i].status == -1
+			&& epoll_ctl(epfd, EPOLL_CTL_ADD, data->stages[i].remote,
+				&ev) == -1)
+			return (-1);
+		i++;
+	}
+	return (0);
+}
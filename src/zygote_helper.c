@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   zygote_helper.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:27:45 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:53:00 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Receives the message of a stage with its descriptors.
+ *
+ * @param[in] sock Socket of the helper.
+ * @param[out] buf Buffer of ZYGOTE_MSG_SIZE bytes receiving the message.
+ * @param[out] fds The ZYGOTE_FDS descriptors of the stage, see
+ *                 `zygote_exec`.
+ * @return Length of the message, 0 if the socket was closed, or -1 if the
+ *         message is invalid.
+ */
+static ssize_t	recv_stage(int sock, char *buf, int *fds)
+{
+	struct msghdr	msg;
+	struct iovec	iov;
+	struct cmsghdr	*cmsg;
+	char			ctrl[CMSG_SPACE(sizeof(int) * ZYGOTE_FDS)];
+	ssize_t			n;
+
+	ft_bzero(&msg, sizeof(msg));
+	iov.iov_base = buf;
+	iov.iov_len = ZYGOTE_MSG_SIZE;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	n = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC | MSG_DONTWAIT);
+	cmsg = NULL;
+	if (n > 0 && buf[n - 1] == '\0')
+		cmsg = CMSG_FIRSTHDR(&msg);
+	if (!cmsg || cmsg->cmsg_level != SOL_SOCKET
+		|| cmsg->cmsg_type != SCM_RIGHTS
+		|| cmsg->cmsg_len != CMSG_LEN(sizeof(int) * ZYGOTE_FDS))
+		return (-(n != 0));
+	ft_memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * ZYGOTE_FDS);
+	return (n);
+}
+
+/**
+ * Builds the argument vector of a stage from its message.
+ *
+ * @param[in] buf The message: path, then arguments.
+ * @param[in] len Length of the message.
+ * @return The arguments, pointing into the message, or NULL if memory runs
+ *         out.
+ */
+static char	**payload_argv(char *buf, ssize_t len)
+{
+	char	**argv;
+	ssize_t	i;
+	int		n;
+
+	n = 0;
+	i = 0;
+	while (i < len)
+		n += (buf[i++] == '\0');
+	argv = ft_calloc(n, sizeof(char *));
+	if (!argv)
+		return (NULL);
+	i = ft_strlen(buf) + 1;
+	n = 0;
+	while (i < len)
+	{
+		argv[n++] = buf + i;
+		i += ft_strlen(buf + i) + 1;
+	}
+	return (argv);
+}
+
+/**
+ * Body of a stage forked by a helper.
+ *
+ * The stage moves to a process group of its own, as the stages pipex forks
+ * do, and to the working directory of its pipeline, makes its
+ * descriptors its standard input, output and error, unblocks every signal
+ * and executes the command.
+ *
+ * @param[in] data Pointer to the t_data structure of the helper, for the
+ *                 environment.
+ * @param[in] buf The message of the stage.
+ * @param[in] len Length of the message.
+ * @param[in] fds The descriptors of the stage.
+ */
+static void	run_stage(t_data *data, char *buf, ssize_t len, int *fds)
+{
+	char		**argv;
+	sigset_t	mask;
+	int			i;
+
+	setpgid(0, 0);
+	argv = payload_argv(buf, len);
+	if (!argv || fchdir(fds[4]) == -1)
+		exit(ERROR);
+	i = 0;
+	while (i < 3)
+	{
+		if (dup2(fds[i], i) == -1)
+			exit(ERROR);
+		fcntl(i++, F_SETFD, 0);
+	}
+	sigemptyset(&mask);
+	sigprocmask(SIG_SETMASK, &mask, NULL);
+	execve(buf, argv, data->envp);
+	ft_printf("pipex: %s: %s\n", argv[0], strerror(errno));
+	exit(ERROR);
+}
+
+/**
+ * Receives a stage on the socket of the helper and forks it.
+ *
+ * The process ID of the stage, or -1 if it could not be forked, is sent
+ * back right away on the socket of the stage, which the helper keeps to
+ * send the wait status on once the stage exits, see `zygote_main`.
+ *
+ * @param[in] data Pointer to the t_data structure of the helper.
+ * @param[out] buf Buffer of ZYGOTE_MSG_SIZE bytes receiving the message.
+ * @param[out] child The stage, with a `pid` of 0 if none was started.
+ * @return 1 if the socket of the helper was closed, 0 otherwise.
+ */
+int	zygote_request(t_data *data, char *buf, t_zygote *child)
+{
+	t_zygote_reply	reply;
+	int				fds[ZYGOTE_FDS];
+	ssize_t			len;
+
+	child->pid = 0;
+	len = recv_stage(3, buf, fds);
+	if (len <= 0)
+		return (len == 0);
+	ft_bzero(&reply, sizeof(reply));
+	reply.pid = fork();
+	if (reply.pid == 0)
+		run_stage(data, buf, len, fds);
+	if (reply.pid > 0)
+		setpgid(reply.pid, reply.pid);
+	send(fds[3], &reply, sizeof(reply), MSG_NOSIGNAL);
+	close(fds[0]);
+	close(fds[1]);
+	close(fds[2]);
+	close(fds[4]);
+	child->sock = fds[3];
+	if (reply.pid > 0)
+		child->pid = reply.pid;
+	else
+		close(fds[3]);
+	return (0);
+}
@@ -0,0 +1,159 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   zygote_loop.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: fde-alen <fde-alen@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:50:30 by fde-alen          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:30 by fde-alen         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * Remembers a stage a helper started, until it exits.
+ *
+ * If memory runs out its socket is closed instead, which leaves the stage
+ * failed for the pipeline, see `wait_remote`.
+ *
+ * @param[in,out] children The stages of the helper still running.
+ * @param[in] child The stage.
+ */
+static void	keep_child(t_list **children, t_zygote *child)
+{
+	t_zygote	*copy;
+	t_list		*node;
+
+	node = NULL;
+	copy = malloc(sizeof(*copy));
+	if (copy)
+		node = ft_lstnew(copy);
+	if (!node)
+	{
+		free(copy);
+		close(child->sock);
+		return ;
+	}
+	*copy = *child;
+	ft_lstadd_front(children, node);
+}
+
+/**
+ * Sends the wait status of a stage that exited on its socket, then forgets
+ * the stage.
+ *
+ * @param[in,out] children The stages of the helper still running.
+ * @param[in] reply The process ID, wait status and resource usage of the
+ *                  stage.
+ */
+static void	send_exit(t_list **children, t_zygote_reply *reply)
+{
+	t_list		**link;
+	t_list		*node;
+	t_zygote	*child;
+
+	link = children;
+	while (*link && ((t_zygote *)(*link)->content)->pid != reply->pid)
+		link = &(*link)->next;
+	if (!*link)
+		return ;
+	node = *link;
+	child = node->content;
+	send(child->sock, reply, sizeof(*reply), MSG_NOSIGNAL);
+	close(child->sock);
+	*link = node->next;
+	ft_lstdelone(node, free);
+}
+
+/**
+ * Reaps every stage of the helper that exited, after SIGCHLD was received
+ * on its signalfd.
+ *
+ * @param[in] sfd The signalfd of the helper.
+ * @param[in,out] children The stages of the helper still running.
+ */
+static void	report_exits(int sfd, t_list **children)
+{
+	struct signalfd_siginfo	info;
+	t_zygote_reply			reply;
+	ssize_t					n;
+
+	n = read(sfd, &info, sizeof(info));
+	while (n == sizeof(info))
+		n = read(sfd, &info, sizeof(info));
+	reply.pid = wait4(-1, &reply.status, WNOHANG, &reply.usage);
+	while (reply.pid > 0)
+	{
+		send_exit(children, &reply);
+		reply.pid = wait4(-1, &reply.status, WNOHANG, &reply.usage);
+	}
+}
+
+/**
+ * Prepares a helper: keeps only its socket, as descriptor 3, restores the
+ * default action of SIGPIPE for its stages and receives SIGCHLD on a
+ * signalfd.
+ *
+ * @param[in] sock Socket of the helper.
+ * @param[out] pfd The socket and the signalfd, to poll.
+ * @return 0 on success, -1 on error.
+ */
+static int	zygote_setup(int sock, struct pollfd *pfd)
+{
+	sigset_t	mask;
+
+	if (sock != 3 && dup3(sock, 3, O_CLOEXEC) == -1)
+		return (-1);
+	syscall(SYS_close_range, 4, ~0U, 0);
+	signal(SIGPIPE, SIG_DFL);
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGCHLD);
+	sigprocmask(SIG_BLOCK, &mask, NULL);
+	pfd[0].fd = 3;
+	pfd[0].events = POLLIN;
+	pfd[1].fd = signalfd(-1, &mask, SFD_CLOEXEC | SFD_NONBLOCK);
+	pfd[1].events = POLLIN;
+	return (-(pfd[1].fd == -1));
+}
+
+/**
+ * Body of a helper forked by `start_zygotes`: a fork server.
+ *
+ * The helper forks every stage it receives, see `zygote_request`, and
+ * reaps it, sending its wait status back to the pipeline, which cannot wait
+ * for a process it did not fork. It stays small, so forking a stage from
+ * it is cheap, and stays up until its socket is closed and every stage it
+ * started was reaped.
+ *
+ * @param[in] data Pointer to the t_data structure of pipex, for the
+ *                 environment.
+ * @param[in] sock Socket of the helper.
+ */
+void	zygote_main(t_data *data, int sock)
+{
+	struct pollfd	pfd[2];
+	t_list			*children;
+	t_zygote		child;
+	char			*buf;
+	int				n;
+
+	buf = malloc(ZYGOTE_MSG_SIZE);
+	if (!buf || zygote_setup(sock, pfd) == -1)
+		exit(ERROR);
+	children = NULL;
+	while (pfd[0].fd != -1 || children)
+	{
+		n = poll(pfd, 2, -1);
+		if (n == -1 && errno != EINTR)
+			exit(ERROR);
+		if (n > 0 && pfd[1].revents)
+			report_exits(pfd[1].fd, &children);
+		if (n > 0 && pfd[0].revents && zygote_request(data, buf, &child))
+			pfd[0].fd = -1;
+		else if (n > 0 && pfd[0].revents && child.pid > 0)
+			keep_child(&children, &child);
+	}
+	exit(0);
+}
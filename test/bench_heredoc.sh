@@ -0,0 +1,43 @@
+#!/bin/bash
+
+#Measures how fast a here_doc body is read, for short lines and for long lines,
+#read whole first and streamed with --heredoc-stream.
+#Usage: ./bench_heredoc.sh [body size in MiB] [runs] [long line size in KiB]
+
+SIZE_MB=${1:-64}
+RUNS=${2:-3}
+LINE_KB=${3:-1024}
+INPUT=test/bench_input.txt
+OUTPUT=test/bench_output.txt
+
+#Colors
+NC="\033[0m"
+BOLD="\033[1m"
+YELLOW="\033[33m"
+
+cd ..
+make > /dev/null
+printf "${YELLOW}${BOLD}$SIZE_MB MiB here_doc body, $RUNS runs${NC}\n"
+for SHAPE in short long; do
+    if [ $SHAPE = short ]; then
+        yes "a short line of a here_doc body" | head -c $((SIZE_MB * 1048576)) > $INPUT
+    else
+        head -c $((SIZE_MB * 1048576)) /dev/zero | tr '\0' 'a' \
+            | fold -w $((LINE_KB * 1024)) > $INPUT
+    fi
+    echo LIMITER >> $INPUT
+    for MODE in whole stream; do
+        OPTS=""
+        [ $MODE = stream ] && OPTS="--heredoc-stream"
+        START=$(date +%s%N)
+        for ((r = 0; r < RUNS; r++)); do
+            rm -f $OUTPUT
+            ./pipex $OPTS here_doc LIMITER "wc -c" "cat" $OUTPUT \
+                < $INPUT > /dev/null
+        done
+        END=$(date +%s%N)
+        printf "%-6s %-6s %6d MB/s\n" $SHAPE $MODE \
+            $(( SIZE_MB * 1048576 * RUNS * 1000 / (END - START) ))
+    done
+done
+rm -f $INPUT $OUTPUT
@@ -0,0 +1,32 @@
+#!/bin/bash
+
+#Compares the per-stage launch latency of the fork and spawn launchers.
+#Usage: ./bench_launch.sh [stages] [runs]
+
+STAGES=${1:-50}
+RUNS=${2:-20}
+INPUT=test/envp.txt
+OUTPUT=test/bench_output.txt
+
+#Colors
+NC="\033[0m"
+BOLD="\033[1m"
+YELLOW="\033[33m"
+
+cd ..
+make > /dev/null
+CMDS=()
+for ((i = 0; i < STAGES; i++)); do
+    CMDS+=("cat")
+done
+printf "${YELLOW}${BOLD}$STAGES stages, $RUNS runs${NC}\n"
+for LAUNCHER in fork spawn; do
+    START=$(date +%s%N)
+    for ((r = 0; r < RUNS; r++)); do
+        ./pipex --no-rewrite --launcher=$LAUNCHER $INPUT "${CMDS[@]}" $OUTPUT
+    done
+    END=$(date +%s%N)
+    printf "%-6s %8d us per stage\n" $LAUNCHER \
+        $(( (END - START) / RUNS / STAGES / 1000 ))
+done
+rm -f $OUTPUT
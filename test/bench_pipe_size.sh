@@ -0,0 +1,33 @@
+#!/bin/bash
+
+#Compares the throughput of a cat | cat | wc -c pipeline for several pipe sizes.
+#Usage: ./bench_pipe_size.sh [input size in MiB] [runs]
+
+SIZE_MB=${1:-1024}
+RUNS=${2:-3}
+INPUT=test/bench_input.bin
+OUTPUT=test/bench_output.txt
+
+#Colors
+NC="\033[0m"
+BOLD="\033[1m"
+YELLOW="\033[33m"
+
+cd ..
+make > /dev/null
+head -c $((SIZE_MB * 1024 * 1024)) /dev/zero > $INPUT
+printf "${YELLOW}${BOLD}$SIZE_MB MiB input, $RUNS runs${NC}\n"
+for SIZE in default 256K 1M auto; do
+    OPTION="--pipe-size=$SIZE"
+    if [ $SIZE = default ]; then
+        OPTION="--"
+    fi
+    START=$(date +%s%N)
+    for ((r = 0; r < RUNS; r++)); do
+        ./pipex --no-rewrite $OPTION $INPUT "cat" "cat" "wc -c" $OUTPUT
+    done
+    END=$(date +%s%N)
+    printf "%-8s %6d MB/s\n" $SIZE \
+        $(( SIZE_MB * 1048576 * RUNS * 1000 / (END - START) ))
+done
+rm -f $INPUT $OUTPUT
@@ -0,0 +1,30 @@
+#!/bin/bash
+
+#Compares the throughput of a 4-stage pipeline for each CPU placement policy.
+#Usage: ./bench_placement.sh [input size in MiB] [runs]
+
+SIZE_MB=${1:-1024}
+RUNS=${2:-3}
+INPUT=test/bench_input.bin
+OUTPUT=test/bench_output.txt
+
+#Colors
+NC="\033[0m"
+BOLD="\033[1m"
+YELLOW="\033[33m"
+
+cd ..
+make > /dev/null
+head -c $((SIZE_MB * 1024 * 1024)) /dev/zero > $INPUT
+printf "${YELLOW}${BOLD}$SIZE_MB MiB input, $RUNS runs, $(nproc) CPUs${NC}\n"
+for PLACEMENT in none compact spread; do
+    START=$(date +%s%N)
+    for ((r = 0; r < RUNS; r++)); do
+        ./pipex --no-rewrite --no-builtins --cpu-placement=$PLACEMENT $INPUT \
+            "cat" "cat" "cat" "wc -c" $OUTPUT
+    done
+    END=$(date +%s%N)
+    printf "%-8s %6d MB/s\n" $PLACEMENT \
+        $(( SIZE_MB * 1048576 * RUNS * 1000 / (END - START) ))
+done
+rm -f $INPUT $OUTPUT
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+#Measures the launch cost per stage for pipelines of 2 to 2000 stages.
+#A constant cost per stage means the total launch cost grows linearly.
+#Usage: ./bench_scaling.sh [runs] [extra pipex options]
+
+RUNS=${1:-5}
+shift
+INPUT=test/envp.txt
+OUTPUT=test/bench_output.txt
+
+#Colors
+NC="\033[0m"
+BOLD="\033[1m"
+YELLOW="\033[33m"
+
+cd ..
+make > /dev/null
+ulimit -n $(ulimit -Hn) 2> /dev/null
+printf "${YELLOW}${BOLD}$RUNS runs, open files limit $(ulimit -n)${NC}\n"
+for STAGES in 2 10 100 500 1000 2000; do
+    if [ $((STAGES * 2 + 16)) -gt $(ulimit -n) ]; then
+        printf "%-6d skipped, open files limit too low\n" $STAGES
+        continue
+    fi
+    CMDS=()
+    for ((i = 0; i < STAGES; i++)); do
+        CMDS+=("cat")
+    done
+    START=$(date +%s%N)
+    for ((r = 0; r < RUNS; r++)); do
+        ./pipex --no-rewrite "$@" $INPUT "${CMDS[@]}" $OUTPUT
+    done
+    END=$(date +%s%N)
+    printf "%-6d %8d us total %6d us per stage\n" $STAGES \
+        $(( (END - START) / RUNS / 1000 )) \
+        $(( (END - START) / RUNS / STAGES / 1000 ))
+done
+rm -f $OUTPUT
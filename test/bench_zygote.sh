@@ -0,0 +1,52 @@
+#!/bin/bash
+
+#Compares the launch-to-exec latency of cold forks and zygotes, per stage.
+#The first and the last stage print the time they were executed on stderr,
+#the gap between the two divided by the number of launches in between is
+#the time pipex spends launching a stage, its own startup left out. "serve"
+#submits the pipeline to a server started with --zygotes, whose helpers are
+#already warm.
+#Usage: ./bench_zygote.sh [stages] [runs]
+
+STAGES=${1:-50}
+RUNS=${2:-20}
+INPUT=test/envp.txt
+OUTPUT=test/bench_output.txt
+SOCK=test/bench_zygote.sock
+
+#Colors
+NC="\033[0m"
+BOLD="\033[1m"
+YELLOW="\033[33m"
+
+cd ..
+make > /dev/null
+STAMP='bash -c echo${IFS}$EPOCHREALTIME>&2'
+CMDS=("$STAMP")
+for ((i = 2; i < STAGES; i++)); do
+    CMDS+=("true")
+done
+CMDS+=("$STAMP")
+
+launch_us() {
+    for ((r = 0; r < RUNS; r++)); do
+        "$@" $INPUT "${CMDS[@]}" $OUTPUT 2>&1 >/dev/null \
+            | sort -n | awk -v n=$STAGES 'NR == 1 { first = $1 } { last = $1 }
+                END { printf "%d\n", (last - first) * 1000000 / (n - 1) }'
+    done | sort -n | awk '{ v[NR] = $1 } END { print v[int((NR + 1) / 2)] }'
+}
+
+printf "${YELLOW}${BOLD}$STAGES stages, $RUNS runs, median${NC}\n"
+for MODE in "--launcher=fork" "--launcher=spawn" "--zygotes=4"; do
+    printf "%-18s %8d us per stage\n" $MODE \
+        $(launch_us ./pipex --no-builtins $MODE)
+done
+rm -f $SOCK
+./pipex --no-builtins --zygotes=4 --serve=$SOCK &
+SERVER=$!
+sleep 0.5
+printf "%-18s %8d us per stage\n" "serve --zygotes=4" \
+    $(launch_us ./pipex --submit=$SOCK)
+kill $SERVER
+wait $SERVER 2> /dev/null
+rm -f $OUTPUT $SOCK
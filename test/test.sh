@@ -297,3 +297,675 @@ else
     printf "${RED}${BOLD}KO: Incorrect number of prompt lines. Expected 1, found $PROMPT_COUNT.${NC}\n"
 fi
 rm -f prompt_output.txt
+
+printf "${PURPLE}${BOLD}\n==================================\n"
+printf                   "|            OPTIONS             |"
+printf                  "\n==================================\n${NC}"
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 1 ===========\n${NC}"
+printf "Stages started with posix_spawn.\n"
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | grep PATH | wc -c > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT cat | grep PATH | wc -c > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --launcher=spawn $INPUT \"cat\" \"grep PATH\" \"wc -c\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --launcher=spawn $INPUT "cat" "grep PATH" "wc -c" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --launcher=spawn $INPUT "cat" "grep PATH" "wc -c" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 2 ===========\n${NC}"
+printf "Command resolution cache, cold then warm run.\n"
+CACHE_HOME=$(mktemp -d)
+printf "Shell command: ${BOLD}${BLUE}<$INPUT grep PATH | wc -c > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT grep PATH | wc -c > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}XDG_CACHE_HOME=$CACHE_HOME ./pipex --cache $INPUT \"grep PATH\" \"wc -c\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+XDG_CACHE_HOME=$CACHE_HOME ./pipex --cache $INPUT "grep PATH" "wc -c" $OUTPUT_PIPEX
+XDG_CACHE_HOME=$CACHE_HOME ./pipex --cache $INPUT "grep PATH" "wc -c" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    XDG_CACHE_HOME=$CACHE_HOME $VALGRIND ./pipex --cache $INPUT "grep PATH" "wc -c" $OUTPUT_PIPEX
+fi
+rm -rf $CACHE_HOME
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 3 ===========\n${NC}"
+printf "Long pipeline of external commands, resolved through the PATH index.\n"
+LONG_PIPE=()
+for i in $(seq 8); do
+    LONG_PIPE+=("cat" "grep -v NO_SUCH_LINE" "sed -n p" "tr a a" "head -n 100000")
+done
+#Empty directories in front of PATH, so that 40 stages times the directories
+#are well above PATH_INDEX_PROBES and the index is built
+INDEX_DIRS=$(mktemp -d)
+INDEX_PATH=$PATH
+for i in $(seq 10); do
+    mkdir $INDEX_DIRS/$i
+    INDEX_PATH=$INDEX_DIRS/$i:$INDEX_PATH
+done
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | grep -v NO_SUCH_LINE | ... | head -n 100000 | wc -l > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+LONG_SHELL=$(printf '%s | ' "${LONG_PIPE[@]}")
+eval "<$INPUT $LONG_SHELL wc -l > $OUTPUT_EXPECTED"
+printf "${NC}Pipex command: ${BOLD}${BLUE}PATH=<10 empty dirs>:\$PATH ./pipex --no-builtins --no-rewrite $INPUT \"cat\" ... \"head -n 100000\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+PATH=$INDEX_PATH ./pipex --no-builtins --no-rewrite $INPUT "${LONG_PIPE[@]}" "wc -l" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    PATH=$INDEX_PATH $VALGRIND ./pipex --no-builtins --no-rewrite $INPUT "${LONG_PIPE[@]}" "wc -l" $OUTPUT_PIPEX
+fi
+rm -rf $INDEX_DIRS
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 4 ===========\n${NC}"
+printf "Builtins disabled, cat, head and wc run their external binaries.\n"
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | head -n 5 | wc -c > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT cat | head -n 5 | wc -c > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --no-builtins $INPUT \"cat\" \"head -n 5\" \"wc -c\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --no-builtins $INPUT "cat" "head -n 5" "wc -c" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --no-builtins $INPUT "cat" "head -n 5" "wc -c" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 5 ===========\n${NC}"
+printf "Rewrite pass, a pipeline of cats becomes a single file copy.\n"
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | cat | cat > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT cat | cat | cat > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --rewrite --print-plan $INPUT \"cat\" \"cat\" \"cat\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+PLAN=$(./pipex --rewrite --print-plan $INPUT "cat" "cat" "cat" $OUTPUT_PIPEX 2>&1)
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+printf "${NC}Plan: "
+if [ "$(printf '%s\n' "$PLAN" | grep -c 'plan: stage')" -eq 1 ] && printf '%s\n' "$PLAN" | grep -q '\[copy\]'; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected a single copy stage${NC}:\n$PLAN\n"
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --rewrite --print-plan $INPUT "cat" "cat" "cat" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 6 ===========\n${NC}"
+printf "Pipe capacities set per pipeline and per pipe.\n"
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | grep PATH | wc -c > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT cat | grep PATH | wc -c > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --pipe-size=auto --pipe-size=2:1M $INPUT \"cat\" \"grep PATH\" \"wc -c\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --pipe-size=auto --pipe-size=2:1M $INPUT "cat" "grep PATH" "wc -c" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --pipe-size=auto --pipe-size=2:1M $INPUT "cat" "grep PATH" "wc -c" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 7 ===========\n${NC}"
+printf "Pipes created just in time, 500 stages with 64 open files at most.\n"
+JIT_PIPE=()
+for i in $(seq 500); do
+    JIT_PIPE+=("cat")
+done
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | ... | cat | wc -l > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT cat | wc -l > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}(ulimit -n 64; ./pipex --jit-pipes $INPUT \"cat\" ... \"cat\" \"wc -l\" $OUTPUT_PIPEX)${NC}\n${YELLOW}"
+(ulimit -n 64; ./pipex --jit-pipes $INPUT "${JIT_PIPE[@]}" "wc -l" $OUTPUT_PIPEX)
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --jit-pipes $INPUT "${JIT_PIPE[@]:0:20}" "wc -l" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 8 ===========\n${NC}"
+printf "Exit status of every stage, compared with the PIPESTATUS of bash.\n"
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | grep NO_SUCH_LINE | wc -l > $OUTPUT_EXPECTED; echo \"PIPESTATUS: \${PIPESTATUS[*]}\"\n${NC}${YELLOW}"
+<$INPUT cat | grep NO_SUCH_LINE | wc -l > $OUTPUT_EXPECTED; EXPECTED_STATUS="PIPESTATUS: ${PIPESTATUS[*]}"
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --rewrite --pipestatus $INPUT \"cat\" \"grep NO_SUCH_LINE\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+PIPEX_STATUS=$(./pipex --rewrite --pipestatus $INPUT "cat" "grep NO_SUCH_LINE" "wc -l" $OUTPUT_PIPEX 2>&1)
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+printf "${NC}Pipe status: "
+if [ "$EXPECTED_STATUS" = "$PIPEX_STATUS" ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected \"$EXPECTED_STATUS\", got \"$PIPEX_STATUS\"${NC}\n"
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --rewrite --pipestatus $INPUT "cat" "grep NO_SUCH_LINE" "wc -l" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 9 ===========\n${NC}"
+printf "Pipeline timeout, a hung stage is stopped and reported with status 124.\n"
+printf "Shell command: ${BOLD}${BLUE}timeout 0.3 sh -c \"<$INPUT sleep 5 | cat > $OUTPUT_EXPECTED\"\n${NC}${YELLOW}"
+timeout 0.3 sh -c "<$INPUT sleep 5 | cat > $OUTPUT_EXPECTED"
+EXPECTED_STATUS=$?
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --timeout=0.3 $INPUT \"sleep 5\" \"cat\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --timeout=0.3 $INPUT "sleep 5" "cat" $OUTPUT_PIPEX
+PIPEX_STATUS=$?
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+printf "${NC}Exit status: "
+if [ $EXPECTED_STATUS -eq $PIPEX_STATUS ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected $EXPECTED_STATUS, got $PIPEX_STATUS${NC}\n"
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --timeout=0.3 $INPUT "sleep 5" "cat" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 10 ==========\n${NC}"
+printf "Resources used by every stage written as JSON.\n"
+STATS_FILE=$(mktemp)
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | sort | wc -l > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT cat | sort | wc -l > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --stats=$STATS_FILE $INPUT \"cat\" \"sort\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --stats=$STATS_FILE $INPUT "cat" "sort" "wc -l" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+printf "${NC}Stats file: "
+if [ "$(grep -o '"maxrss_kb"' $STATS_FILE | wc -l)" -eq 3 ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected 3 stages${NC}:\n"
+    cat $STATS_FILE
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --stats=$STATS_FILE $INPUT "cat" "sort" "wc -l" $OUTPUT_PIPEX
+fi
+rm -f $STATS_FILE
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 11 ==========\n${NC}"
+printf "Traffic of every pipe counted by a relay.\n"
+METER_FILE=$(mktemp)
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | sort | wc -l > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT cat | sort | wc -l > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --meter $INPUT \"cat\" \"sort\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --meter $INPUT "cat" "sort" "wc -l" $OUTPUT_PIPEX 2> $METER_FILE
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+printf "${NC}Bytes relayed: "
+if [ "$(awk '$1 == 1 { print $2 }' $METER_FILE)" = "$(wc -c < $INPUT | tr -d ' ')" ] \
+    && [ "$(awk '$1 == 2 { print $2 }' $METER_FILE)" = "$(sort $INPUT | wc -c | tr -d ' ')" ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected the sizes of the input and of its sorted copy${NC}:\n"
+    cat $METER_FILE
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --meter $INPUT "cat" "sort" "wc -l" $OUTPUT_PIPEX
+fi
+rm -f $METER_FILE
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 12 ==========\n${NC}"
+printf "A stage run as 3 workers on chunks of the input, in input order.\n"
+PARALLEL_INPUT=$(mktemp)
+seq 1 1500000 > $PARALLEL_INPUT
+printf "Shell command: ${BOLD}${BLUE}<$PARALLEL_INPUT grep 7 | cat > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$PARALLEL_INPUT grep 7 | cat > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --parallel=3:1 $PARALLEL_INPUT \"grep 7\" \"cat\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --parallel=3:1 $PARALLEL_INPUT "grep 7" "cat" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}\n"
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --parallel=3:1 $PARALLEL_INPUT "grep 7" "cat" $OUTPUT_PIPEX
+fi
+rm -f $PARALLEL_INPUT
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 13 ==========\n${NC}"
+printf "Output of the first stage sent to a second pipeline as well.\n"
+BRANCH_EXPECTED=$(mktemp)
+BRANCH_PIPEX=$(mktemp)
+printf "Shell command: ${BOLD}${BLUE}<$INPUT grep a | tee >(wc -l > $BRANCH_EXPECTED) | sort > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT grep a | sort > $OUTPUT_EXPECTED
+<$INPUT grep a | wc -l > $BRANCH_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex \"--tee=1:$BRANCH_PIPEX:wc -l\" $INPUT \"grep a\" \"sort\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex "--tee=1:$BRANCH_PIPEX:wc -l" $INPUT "grep a" "sort" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+printf "${NC}Branch file: "
+if cmp -s $BRANCH_EXPECTED $BRANCH_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Branch output differs${NC}:\n"
+    diff --color -c $BRANCH_EXPECTED $BRANCH_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex "--tee=1:$BRANCH_PIPEX:wc -l" $INPUT "grep a" "sort" $OUTPUT_PIPEX
+fi
+rm -f $BRANCH_EXPECTED $BRANCH_PIPEX
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 14 ==========\n${NC}"
+printf "Two sorted inputs merged into a single sorted stream.\n"
+MERGE_A=$(mktemp)
+MERGE_B=$(mktemp)
+LC_ALL=C sort $INPUT > $MERGE_A
+grep a $INPUT | LC_ALL=C sort > $MERGE_B
+printf "Shell command: ${BOLD}${BLUE}LC_ALL=C sort -m $MERGE_A $MERGE_B | cat > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+LC_ALL=C sort -m $MERGE_A $MERGE_B | cat > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --merge=sorted --input=$MERGE_B $MERGE_A \"cat\" \"cat\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --merge=sorted --input=$MERGE_B $MERGE_A "cat" "cat" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --merge=sorted --input=$MERGE_B $MERGE_A "cat" "cat" $OUTPUT_PIPEX
+fi
+rm -f $MERGE_A $MERGE_B
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 15 ==========\n${NC}"
+printf "Three pipelines of a manifest run by a pool of two.\n"
+MANIFEST=$(mktemp)
+BATCH_OUT=$(mktemp -d)
+printf "$INPUT\tsort\tuniq\t$BATCH_OUT/1\n" > $MANIFEST
+printf "$INPUT\tgrep a\twc -l\t$BATCH_OUT/2\n" >> $MANIFEST
+printf "$INPUT\tcat\thead -5\t$BATCH_OUT/3\n" >> $MANIFEST
+printf "Shell command: ${BOLD}${BLUE}sort $INPUT | uniq; grep a $INPUT | wc -l; head -5 $INPUT > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+(sort $INPUT | uniq; grep a $INPUT | wc -l; head -5 $INPUT) > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --jobs=2 --batch=$MANIFEST${NC}\n${YELLOW}"
+./pipex --jobs=2 --batch=$MANIFEST
+cat $BATCH_OUT/1 $BATCH_OUT/2 $BATCH_OUT/3 > $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --jobs=2 --batch=$MANIFEST
+fi
+printf "$INPUT\tcat\t\twc -l\t$BATCH_OUT/4\n" >> $MANIFEST
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --batch=$MANIFEST${NC}, with an empty field on line 4\n${YELLOW}"
+BATCH_ERROR=$(./pipex --batch=$MANIFEST 2>&1)
+printf "${NC}Empty field: "
+if [ "$BATCH_ERROR" = "pipex: $MANIFEST:4: invalid pipeline" ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected \"pipex: $MANIFEST:4: invalid pipeline\", got \"$BATCH_ERROR\"${NC}\n"
+fi
+rm -rf $MANIFEST $BATCH_OUT
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 16 ==========\n${NC}"
+printf "A pipeline submitted to a server listening on a Unix socket.\n"
+SOCKET=$(mktemp -u)
+./pipex --serve=$SOCKET &
+SERVER=$!
+for i in 1 2 3 4 5 6 7 8 9 10; do
+    [ -S $SOCKET ] && break
+    sleep 0.1
+done
+printf "Shell command: ${BOLD}${BLUE}< $INPUT grep a | wc -l > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+< $INPUT grep a | wc -l > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --submit=$SOCKET $INPUT \"grep a\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --submit=$SOCKET $INPUT "grep a" "wc -l" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --submit=$SOCKET $INPUT "grep a" "wc -l" $OUTPUT_PIPEX
+fi
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --submit=$SOCKET --timeout=1 $INPUT \"grep a\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --submit=$SOCKET --timeout=1 $INPUT "grep a" "wc -l" $OUTPUT_PIPEX
+PIPEX_STATUS=$?
+printf "${NC}Exit status: "
+if [ "$PIPEX_STATUS" -eq 1 ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected 1, got $PIPEX_STATUS${NC}\n"
+fi
+kill $SERVER
+wait $SERVER
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 17 ==========\n${NC}"
+printf "Stages handed to the helpers of --zygotes, the one tuned with --nice left to a cold fork.\n"
+printf "Shell command: ${BOLD}${BLUE}< $INPUT cat | sort | uniq -c | wc -l > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+< $INPUT cat | sort | uniq -c | wc -l > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --no-builtins --zygotes=2 --nice=4:5 $INPUT \"cat\" \"sort\" \"uniq -c\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --no-builtins --zygotes=2 --nice=4:5 $INPUT "cat" "sort" "uniq -c" "wc -l" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --no-builtins --zygotes=2 --nice=4:5 $INPUT "cat" "sort" "uniq -c" "wc -l" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 18 ==========\n${NC}"
+printf "A stage pinned to the first CPU with --cpus, the others placed compact.\n"
+printf "Shell command: ${BOLD}${BLUE}grep Cpus_allowed_list /proc/self/status | sed 's/TAB.*/TAB0/' > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+grep Cpus_allowed_list /proc/self/status | sed 's/\t.*/\t0/' > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --cpu-placement=compact --cpus=1:0 $INPUT \"grep Cpus_allowed_list /proc/self/status\" \"cat\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --cpu-placement=compact --cpus=1:0 $INPUT "grep Cpus_allowed_list /proc/self/status" "cat" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --cpu-placement=compact --cpus=1:0 $INPUT "grep Cpus_allowed_list /proc/self/status" "cat" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 19 ==========\n${NC}"
+printf "The last stage run at nice 7 with SCHED_BATCH through --nice and --sched.\n"
+printf "Shell command: ${BOLD}${BLUE}echo 7 > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+echo 7 > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --nice=2:7 --sched=2:batch $INPUT \"sort\" \"nice\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --nice=2:7 --sched=2:batch $INPUT "sort" "nice" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --nice=2:7 --sched=2:batch $INPUT "sort" "nice" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 20 ==========\n${NC}"
+printf "A here_doc body larger than a pipe, moved to a memfd, then to a temporary file past --heredoc-spill.\n"
+printf "Shell command: ${BOLD}${BLUE}seq 1 50000 | sort -r | wc -c > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+seq 1 50000 | sort -r | wc -c > $OUTPUT_EXPECTED
+rm -f $OUTPUT_PIPEX
+printf "${NC}Pipex command: ${BOLD}${BLUE}(seq 1 50000; echo LIMITER) | ./pipex --heredoc-spill=128K here_doc LIMITER \"sort -r\" \"wc -c\" $OUTPUT_PIPEX > /dev/null${NC}\n${YELLOW}"
+(seq 1 50000; echo LIMITER) | ./pipex --heredoc-spill=128K here_doc LIMITER "sort -r" "wc -c" $OUTPUT_PIPEX > /dev/null
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    rm -f $OUTPUT_PIPEX
+    (seq 1 50000; echo LIMITER) | $VALGRIND ./pipex --heredoc-spill=128K here_doc LIMITER "sort -r" "wc -c" $OUTPUT_PIPEX > /dev/null
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 21 ==========\n${NC}"
+printf "An endless here_doc body streamed with --heredoc-stream to a first stage that stops reading.\n"
+printf "Shell command: ${BOLD}${BLUE}yes | head -1 | cat > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+yes | head -1 | cat > $OUTPUT_EXPECTED
+rm -f $OUTPUT_PIPEX
+printf "${NC}Pipex command: ${BOLD}${BLUE}yes | timeout 10 ./pipex --heredoc-stream here_doc LIMITER \"head -1\" \"cat\" $OUTPUT_PIPEX > /dev/null${NC}\n${YELLOW}"
+yes | timeout 10 ./pipex --heredoc-stream here_doc LIMITER "head -1" "cat" $OUTPUT_PIPEX > /dev/null
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    rm -f $OUTPUT_PIPEX
+    (seq 1 50000; echo LIMITER) | $VALGRIND ./pipex --heredoc-stream here_doc LIMITER "head -1" "cat" $OUTPUT_PIPEX > /dev/null
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 22 ==========\n${NC}"
+printf "Rewrite pass with a per-stage option and with a missing infile, stages and exit status unchanged.\n"
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | timeout 0.2 sleep 3 | cat > $OUTPUT_EXPECTED; echo \"PIPESTATUS: \${PIPESTATUS[*]}\"\n${NC}${YELLOW}"
+<$INPUT cat | timeout 0.2 sleep 3 | cat > $OUTPUT_EXPECTED; EXPECTED_STATUS="PIPESTATUS: ${PIPESTATUS[*]}"
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --rewrite --pipestatus --stage-timeout=2:0.2 $INPUT \"cat\" \"sleep 3\" \"cat\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+PIPEX_STATUS=$(./pipex --rewrite --pipestatus --stage-timeout=2:0.2 $INPUT "cat" "sleep 3" "cat" $OUTPUT_PIPEX 2>&1)
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+printf "${NC}Pipe status: "
+if [ "$EXPECTED_STATUS" = "$PIPEX_STATUS" ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected \"$EXPECTED_STATUS\", got \"$PIPEX_STATUS\"${NC}\n"
+fi
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --rewrite $INPUT_INVALID \"cat\" \"cat\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex --rewrite $INPUT_INVALID "cat" "cat" $OUTPUT_PIPEX
+PIPEX_STATUS=$?
+printf "${NC}Exit status: "
+if [ "$PIPEX_STATUS" -eq 0 ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected 0, got $PIPEX_STATUS${NC}\n"
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --rewrite --pipestatus --stage-timeout=2:0.2 $INPUT "cat" "sleep 3" "cat" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 23 ==========\n${NC}"
+printf "Per-stage options naming a stage or a pipe past the end of the plan.\n"
+for OPT in --stage-timeout=3:1 --parallel=2:3 --nice=3:5 --pipe-size=2:4096 --meter=2 "--tee=3:$OUTPUT_PIPEX:cat"; do
+    printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex $OPT $INPUT \"cat\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+    ./pipex $OPT $INPUT "cat" "wc -l" $OUTPUT_PIPEX
+    PIPEX_STATUS=$?
+    printf "${NC}Exit status: "
+    if [ "$PIPEX_STATUS" -eq 1 ]; then
+        printf "${GREEN}${BOLD}OK!${NC}\n"
+    else
+        printf "${RED}${BOLD}KO: Expected 1, got $PIPEX_STATUS${NC}\n"
+    fi
+done
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --stage-timeout=3:1 $INPUT "cat" "wc -l" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 24 ==========\n${NC}"
+printf "Branch command holding an escaped '|', and a failing branch.\n"
+BRANCH_EXPECTED=$(mktemp)
+BRANCH_PIPEX=$(mktemp)
+printf "Shell command: ${BOLD}${BLUE}<$INPUT cat | tee >(grep -E 'PATH|HOME' > $BRANCH_EXPECTED) | wc -l > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+<$INPUT cat | wc -l > $OUTPUT_EXPECTED
+<$INPUT grep -E 'PATH|HOME' > $BRANCH_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex \"--tee=1:$BRANCH_PIPEX:grep -E PATH\\\\|HOME\" $INPUT \"cat\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex "--tee=1:$BRANCH_PIPEX:grep -E PATH\|HOME" $INPUT "cat" "wc -l" $OUTPUT_PIPEX
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+printf "${NC}Branch file: "
+if cmp -s $BRANCH_EXPECTED $BRANCH_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Branch output differs${NC}:\n"
+    diff --color -c $BRANCH_EXPECTED $BRANCH_PIPEX
+fi
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex \"--tee=1:$BRANCH_PIPEX:false\" $INPUT \"cat\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+./pipex "--tee=1:$BRANCH_PIPEX:false" $INPUT "cat" "wc -l" $OUTPUT_PIPEX
+PIPEX_STATUS=$?
+printf "${NC}Exit status: "
+if [ "$PIPEX_STATUS" -eq 1 ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected 1, got $PIPEX_STATUS${NC}\n"
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex "--tee=1:$BRANCH_PIPEX:grep -E PATH\|HOME" $INPUT "cat" "wc -l" $OUTPUT_PIPEX
+fi
+rm -f $BRANCH_EXPECTED $BRANCH_PIPEX
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 25 ==========\n${NC}"
+printf "Inputs that fail make pipex fail, the others are still merged.\n"
+for OPT in "--input=$INPUT:nosuchcmd" "--input=$INPUT:false" "--input=/nonexist"; do
+    printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex \"$OPT\" $INPUT \"cat\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+    ./pipex "$OPT" $INPUT "cat" "wc -l" $OUTPUT_PIPEX
+    PIPEX_STATUS=$?
+    printf "${NC}Exit status: "
+    if [ "$PIPEX_STATUS" -ne 0 ]; then
+        printf "${GREEN}${BOLD}OK!${NC}\n"
+    else
+        printf "${RED}${BOLD}KO: Expected a failure, got 0${NC}\n"
+    fi
+done
+<$INPUT wc -l > $OUTPUT_EXPECTED
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex "--input=/nonexist" $INPUT "cat" "wc -l" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 26 ==========\n${NC}"
+printf "Streamed here_doc body ending before LIMITER.\n"
+printf "${NC}Pipex command: ${BOLD}${BLUE}printf \"a\\\\nb\\\\n\" | ./pipex --heredoc-stream here_doc LIMITER \"cat\" \"wc -l\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+printf "a\nb\n" | ./pipex --heredoc-stream here_doc LIMITER "cat" "wc -l" $OUTPUT_PIPEX > /dev/null
+PIPEX_STATUS=$?
+printf "${NC}Exit status: "
+if [ "$PIPEX_STATUS" -ne 0 ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected a failure, got 0${NC}\n"
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    printf "a\nb\n" | $VALGRIND ./pipex --heredoc-stream here_doc LIMITER "cat" "wc -l" $OUTPUT_PIPEX > /dev/null
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 27 ==========\n${NC}"
+printf "Stage deadline reaching a child that outlives the stage.\n"
+printf "${NC}Pipex command: ${BOLD}${BLUE}./pipex --stage-timeout=1:0.2 --kill-after=0.1 $INPUT 'sh -c trap\${IFS}\"\"\${IFS}TERM;sleep\${IFS}3' \"cat\" $OUTPUT_PIPEX${NC}\n${YELLOW}"
+START=$(date +%s%N)
+./pipex --stage-timeout=1:0.2 --kill-after=0.1 $INPUT 'sh -c trap${IFS}""${IFS}TERM;sleep${IFS}3' "cat" $OUTPUT_PIPEX
+PIPEX_STATUS=$?
+ELAPSED=$(( ($(date +%s%N) - START) / 1000000 ))
+printf "${NC}Exit status and time: "
+if [ "$PIPEX_STATUS" -eq 124 ] && [ "$ELAPSED" -lt 2000 ]; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Expected 124 within 2000 ms, got $PIPEX_STATUS after $ELAPSED ms${NC}\n"
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    $VALGRIND ./pipex --stage-timeout=1:0.2 --kill-after=0.1 $INPUT 'sh -c trap${IFS}""${IFS}TERM;sleep${IFS}3' "cat" $OUTPUT_PIPEX
+fi
+
+printf "${YELLOW}${BOLD}\n======== OPTIONS TEST 28 ==========\n${NC}"
+printf "Command resolution cache with a relative PATH entry, run from two directories.\n"
+CACHE_HOME=$(mktemp -d)
+mkdir -p $CACHE_HOME/a/bin $CACHE_HOME/b/bin
+printf '#!/bin/sh\necho a\n' > $CACHE_HOME/a/bin/tool
+chmod +x $CACHE_HOME/a/bin/tool
+touch -r $CACHE_HOME/a/bin $CACHE_HOME/b/bin
+printf "Shell command: ${BOLD}${BLUE}echo a > $OUTPUT_EXPECTED\n${NC}${YELLOW}"
+echo a > $OUTPUT_EXPECTED
+printf "${NC}Pipex command: ${BOLD}${BLUE}(cd DIR && PATH=bin:\$PATH ./pipex --cache $INPUT \"tool\" \"cat\" $OUTPUT_PIPEX), DIR b then a${NC}\n${YELLOW}"
+for DIR in b a; do
+    (cd $CACHE_HOME/$DIR && PATH=bin:$PATH XDG_CACHE_HOME=$CACHE_HOME $OLDPWD/pipex --cache $OLDPWD/$INPUT "tool" "cat" $OLDPWD/$OUTPUT_PIPEX)
+done
+printf "${NC}Output file: "
+if cmp -s $OUTPUT_EXPECTED $OUTPUT_PIPEX; then
+    printf "${GREEN}${BOLD}OK!${NC}\n"
+else
+    printf "${RED}${BOLD}KO: Output differs${NC}:\n"
+    diff --color -c $OUTPUT_EXPECTED $OUTPUT_PIPEX
+fi
+if [ $LEAK_TOGGLE -eq 1 ]; then
+    printf "Leak check:${CYAN}\n"
+    (cd $CACHE_HOME/a && PATH=bin:$PATH XDG_CACHE_HOME=$CACHE_HOME $VALGRIND $OLDPWD/pipex --cache $OLDPWD/$INPUT "tool" "cat" $OLDPWD/$OUTPUT_PIPEX)
+fi
+rm -rf $CACHE_HOME